@@ -0,0 +1,282 @@
+// fillArc / drawArc (fill_arc_helper) の速度と描画結果を、整数化する前の実装と比較する (PC上で実行する);
+// 開始角を変えながら 1°～360° の各角度幅の円弧・楕円弧を描き、;
+//  - 旧実装との差が1画素を超える画素 (8近傍に旧実装の画素がない画素) があれば失敗として終了コード1を返す;
+//  - 240x240 16bpp の Sprite に半径110・幅20の円弧を描く時間を比較する;
+//
+// usage : LGFXArcBench [repeat]
+//   repeat : 速度測定で各角度幅を描く回数 (省略時 200);
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <limits>
+#include <chrono>
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+
+static constexpr float deg_to_rad = 0.017453292519943295769236907684886;
+
+// 整数化する前の fill_arc_helper と、それを使う fillEllipseArc / drawEllipseArc;
+class OldArcSprite : public LGFX_Sprite
+{
+public:
+  void fillEllipseArcOld(int32_t x, int32_t y, int32_t r0x, int32_t r1x, int32_t r0y, int32_t r1y, float start, float end)
+  {
+    if (!normalize(r0x, r1x, r0y, r1y)) return;
+    bool equal = fabsf(start - end) < std::numeric_limits<float>::epsilon();
+    normalize_angle(start, end);
+    if (!equal && (fabsf(start - end) <= 0.0001)) { start = .0; end = 360.0; }
+    startWrite();
+    fill_arc_helper_old(x, y, r0x, r1x, r0y, r1y, start, end);
+    endWrite();
+  }
+
+  void drawEllipseArcOld(int32_t x, int32_t y, int32_t r0x, int32_t r1x, int32_t r0y, int32_t r1y, float start, float end)
+  {
+    if (!normalize(r0x, r1x, r0y, r1y)) return;
+    bool equal = fabsf(start - end) < std::numeric_limits<float>::epsilon();
+    normalize_angle(start, end);
+    startWrite();
+    fill_arc_helper_old(x, y, r0x, r1x, r0y, r1y, start, start);
+    fill_arc_helper_old(x, y, r0x, r1x, r0y, r1y, end, end);
+    if (!equal && (fabsf(start - end) <= 0.0001)) { start = .0; end = 360.0; }
+    fill_arc_helper_old(x, y, r0x, r0x, r0y, r0y, start, end);
+    fill_arc_helper_old(x, y, r1x, r1x, r1y, r1y, start, end);
+    endWrite();
+  }
+
+private:
+  static bool normalize(int32_t& r0x, int32_t& r1x, int32_t& r0y, int32_t& r1y)
+  {
+    if (r0x < r1x) std::swap(r0x, r1x);
+    if (r0y < r1y) std::swap(r0y, r1y);
+    return (r1x >= 0 && r1y >= 0);
+  }
+
+  static void normalize_angle(float& start, float& end)
+  {
+    start = fmodf(start, 360);
+    end = fmodf(end, 360);
+    if (start < 0) start += 360.0;
+    if (end < 0) end += 360.0;
+  }
+
+  void fill_arc_helper_old(int32_t cx, int32_t cy, int32_t oradius_x, int32_t iradius_x, int32_t oradius_y, int32_t iradius_y, float start, float end)
+  {
+    float s_cos = (cosf(start * deg_to_rad));
+    float e_cos = (cosf(end * deg_to_rad));
+    float sslope = s_cos / (sinf(start * deg_to_rad));
+    float eslope = -1000000;
+    if (end != 360.0) eslope = e_cos / (sinf(end * deg_to_rad));
+    float swidth =  0.5 / s_cos;
+    float ewidth = -0.5 / e_cos;
+
+    bool start180 = !(start < 180);
+    bool end180 = end < 180;
+    bool reversed = start + 180 < end || (end < start && start < end + 180);
+
+    int32_t xleft  = -oradius_x;
+    int32_t xright = oradius_x + 1;
+    int32_t y = -oradius_y;
+    int32_t ye = oradius_y;
+    if (!reversed)
+    {
+      if (    (end >= 270 || end <  90) && (start >= 270 || start <  90)) xleft = 0;
+      else if (end <  270 && end >= 90  &&  start <  270 && start >= 90) xright = 1;
+      if (     end >= 180 && start >= 180) ye = 0;
+      else if (end <  180 && start <  180) y = 0;
+    }
+    if (y  < _clip_t - cy    ) y  = _clip_t - cy;
+    if (ye > _clip_b - cy + 1) ye = _clip_b - cy + 1;
+
+    if (xleft  < _clip_l - cx    ) xleft  = _clip_l - cx;
+    if (xright > _clip_r - cx + 1) xright = _clip_r - cx + 1;
+
+    bool trueCircle = (oradius_x == oradius_y) && (iradius_x == iradius_y);
+
+    int32_t iradius_y2 = iradius_y * (iradius_y - 1);
+    int32_t iradius_x2 = iradius_x * (iradius_x - 1);
+    float irad_rate = iradius_x2 && iradius_y2 ? (float)iradius_x2 / (float)iradius_y2 : 0;
+
+    int32_t oradius_y2 = oradius_y * (oradius_y + 1);
+    int32_t oradius_x2 = oradius_x * (oradius_x + 1);
+    float orad_rate = oradius_x2 && oradius_y2 ? (float)oradius_x2 / (float)oradius_y2 : 0;
+
+    do
+    {
+      int32_t y2 = y * y;
+      int32_t compare_o = oradius_y2 - y2;
+      int32_t compare_i = iradius_y2 - y2;
+      if (!trueCircle)
+      {
+        compare_i = floorf(compare_i * irad_rate);
+        compare_o = ceilf (compare_o * orad_rate);
+      }
+      int32_t xe = ceilf(sqrtf(compare_o));
+      int32_t x = 1 - xe;
+
+      if ( x < xleft )  x = xleft;
+      if (xe > xright) xe = xright;
+      float ysslope = (y + swidth) * sslope;
+      float yeslope = (y + ewidth) * eslope;
+      int len = 0;
+      do
+      {
+        bool flg1 = start180 != (x <= ysslope);
+        bool flg2 =   end180 != (x <= yeslope);
+        int32_t x2 = x * x;
+        if (x2 >= compare_i
+         && ((flg1 && flg2) || (reversed && (flg1 || flg2)))
+         && x != xe
+         && x2 < compare_o)
+        {
+          ++len;
+        }
+        else
+        {
+          if (len)
+          {
+            writeFastHLine(cx + x - len, cy + y, len);
+            len = 0;
+          }
+          if (x2 >= compare_o) break;
+          if (x < 0 && x2 < compare_i) { x = -x; }
+        }
+      } while (++x <= xe);
+    } while (++y <= ye);
+  }
+};
+
+// 差のある画素数と、そのうち1画素を超えて離れている画素数、旧実装で描かれた画素数を返す;
+static int compare(LGFX_Sprite& a, LGFX_Sprite& b, int* far, int* drawn)
+{
+  int w = a.width(), h = a.height();
+  auto pa = (const uint8_t*)a.getBuffer();
+  auto pb = (const uint8_t*)b.getBuffer();
+  auto at = [&](const uint8_t* p, int x, int y) { return (x < 0 || y < 0 || x >= w || y >= h) ? 0 : p[x + y * w]; };
+  int diff = 0;
+  *far = 0;
+  *drawn = 0;
+  for (int y = 0; y < h; ++y)
+  {
+    for (int x = 0; x < w; ++x)
+    {
+      int va = at(pa, x, y);
+      *drawn += (va != 0);
+      if (va == at(pb, x, y)) continue;
+      ++diff;
+      auto other = va ? pb : pa;
+      bool near = false;
+      for (int dy = -1; dy <= 1 && !near; ++dy)
+      {
+        for (int dx = -1; dx <= 1; ++dx)
+        {
+          if (at(other, x + dx, y + dy)) { near = true; break; }
+        }
+      }
+      if (!near) { ++*far; }
+    }
+  }
+  return diff;
+}
+
+struct arc_case_t
+{
+  const char* name;
+  int32_t r0x, r1x, r0y, r1y;
+  bool draw;
+};
+
+static const arc_case_t arc_cases[] =
+{ { "fillArc"        , 110, 90, 110, 90, false }
+, { "fillArc r0"     ,  70,  0,  70,  0, false }
+, { "fillEllipseArc" , 110, 60,  70, 40, false }
+, { "drawArc"        , 110, 90, 110, 90, true  }
+, { "drawEllipseArc" ,  60, 30, 110, 80, true  }
+};
+
+static const float start_angles[] = { 0.0f, 37.5f, 90.0f, 181.25f, 300.0f, -45.0f };
+
+int main(int argc, char** argv)
+{
+  int repeat = (argc > 1) ? atoi(argv[1]) : 200;
+  if (repeat < 1) { repeat = 1; }
+
+  OldArcSprite a, b;
+  for (auto s : { &a, &b })
+  {
+    s->setColorDepth(8);
+    s->createSprite(240, 240);
+  }
+
+  // 描画結果の比較;
+  int fails = 0;
+  printf("%-16s %8s %10s %10s %10s %8s\n", "shape", "arcs", "drawn px", "with diff", "diff px", "far px");
+  for (auto& c : arc_cases)
+  {
+    int arcs = 0, arcs_diff = 0;
+    long drawn_total = 0, diff_total = 0, far_total = 0;
+    for (float start : start_angles)
+    {
+      for (int span = 1; span <= 360; ++span)
+      {
+        a.fillScreen(TFT_BLACK);
+        b.fillScreen(TFT_BLACK);
+        a.setColor(TFT_WHITE);
+        b.setColor(TFT_WHITE);
+        if (c.draw)
+        {
+          a.drawEllipseArcOld(120, 120, c.r0x, c.r1x, c.r0y, c.r1y, start, start + span);
+          b.drawEllipseArc   (120, 120, c.r0x, c.r1x, c.r0y, c.r1y, start, start + span);
+        }
+        else
+        {
+          a.fillEllipseArcOld(120, 120, c.r0x, c.r1x, c.r0y, c.r1y, start, start + span);
+          b.fillEllipseArc   (120, 120, c.r0x, c.r1x, c.r0y, c.r1y, start, start + span);
+        }
+        int far, drawn;
+        int diff = compare(a, b, &far, &drawn);
+        drawn_total += drawn;
+        ++arcs;
+        arcs_diff += (diff != 0);
+        diff_total += diff;
+        far_total += far;
+        if (far && fails < 10)
+        {
+          printf("  %s start %g span %d : %d px farther than 1 px\n", c.name, start, span, far);
+        }
+        fails += (far != 0);
+      }
+    }
+    printf("%-16s %8d %10ld %10d %10ld %8ld\n", c.name, arcs, drawn_total, arcs_diff, diff_total, far_total);
+  }
+
+  // 速度 (16bpp 240x240 の Sprite に半径110・幅20の円弧);
+  OldArcSprite sp;
+  sp.setColorDepth(16);
+  sp.createSprite(240, 240);
+  sp.setColor(TFT_WHITE);
+  printf("\n%8s %12s %12s %8s   (%d arcs each)\n", "span", "old us", "new us", "ratio", repeat);
+  double total_old = 0, total_new = 0;
+  for (int span = 1; span <= 360; ++span)
+  {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < repeat; ++k) { sp.fillEllipseArcOld(120, 120, 110, 90, 110, 90, (float)(k % 360), (float)(k % 360 + span)); }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int k = 0; k < repeat; ++k) { sp.fillArc(120, 120, 110, 90, (float)(k % 360), (float)(k % 360 + span)); }
+    auto t2 = std::chrono::steady_clock::now();
+    double uo = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    double un = std::chrono::duration<double, std::micro>(t2 - t1).count();
+    total_old += uo;
+    total_new += un;
+    if (span == 1 || span == 10 || span == 45 || span == 90 || span == 180 || span == 270 || span == 359 || span == 360)
+    {
+      printf("%8d %12.0f %12.0f %7.2fx\n", span, uo, un, un ? uo / un : 0.0);
+    }
+  }
+  printf("%8s %12.0f %12.0f %7.2fx\n", "1-360", total_old, total_new, total_new ? total_old / total_new : 0.0);
+
+  printf("\n%s\n", fails ? "FAILED : some pixels are farther than 1 px from the previous implementation" : "OK : all arcs are within 1 px of the previous implementation");
+  return fails ? 1 : 0;
+}
@@ -0,0 +1,170 @@
+// AtlasFont 変換ツール (PC上で実行する);
+// 指定したフォントの指定範囲の文字を AtlasFont 形式に変換し、C言語の配列として標準出力に書き出す。;
+//
+// usage : LGFXAtlas <font> <array name> [first-last ...]
+//   ex. : LGFXAtlas efontJA_16 atlas_ja16 20-7E 3000-30FF 4E00-4E9F > atlas_ja16.h
+//   ex. : LGFXAtlas NotoSansJP-20.vlw atlas_noto20 20-7E 3040-30FF > atlas_noto20.h
+//
+// <font> には下記の font_table の名前の他、以下のファイルを指定できる;
+//   *.vlw  : Processing で作成した VLW 形式のフォント;
+//   *.u8g2 : U8g2 形式のフォントデータ (u8g2_font_xxx の配列の中身) をそのまま保存したバイナリ;
+//
+// 生成したヘッダを組み込み、以下のように使用する;
+//   static constexpr lgfx::AtlasFont atlas_font(atlas_ja16);
+//   lcd.setFont(&atlas_font);
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+
+#include "adobex11font.h"
+
+static const lgfx::U8g2font helvR14 ( u8g2_font_helvR14_tr );
+static const lgfx::U8g2font courR14 ( u8g2_font_courR14_tr );
+
+struct font_entry_t
+{
+  const char* name;
+  const lgfx::IFont* font;
+};
+
+static const font_entry_t font_table[] =
+{ { "Font0"           , &fonts::Font0            }  // GLCD
+, { "Font2"           , &fonts::Font2            }  // BMP
+, { "Font4"           , &fonts::Font4            }  // RLE
+, { "FreeSans9pt7b"   , &fonts::FreeSans9pt7b    }  // GFX
+, { "FreeSans12pt7b"  , &fonts::FreeSans12pt7b   }
+, { "FreeSans18pt7b"  , &fonts::FreeSans18pt7b   }
+, { "helvR14"         , &helvR14                 }  // U8g2
+, { "courR14"         , &courR14                 }
+, { "lgfxJapanGothic_16", &fonts::lgfxJapanGothic_16 }
+, { "lgfxJapanGothic_24", &fonts::lgfxJapanGothic_24 }
+, { "lgfxJapanGothicP_16", &fonts::lgfxJapanGothicP_16 }
+, { "lgfxJapanMincho_16", &fonts::lgfxJapanMincho_16 }
+, { "lgfxJapanMincho_24", &fonts::lgfxJapanMincho_24 }
+, { "efontJA_16"      , &fonts::efontJA_16       }
+, { "efontJA_24"      , &fonts::efontJA_24       }
+, { "efontCN_16"      , &fonts::efontCN_16       }
+, { "efontKR_16"      , &fonts::efontKR_16       }
+, { "efontTW_16"      , &fonts::efontTW_16       }
+};
+
+static bool has_suffix(const char* str, const char* suffix)
+{
+  size_t len = strlen(str);
+  size_t slen = strlen(suffix);
+  return len >= slen && strcmp(&str[len - slen], suffix) == 0;
+}
+
+// ファイルの内容を全て読み込む (変換が終わるまで保持するため解放しない);
+static uint8_t* load_file(const char* path, size_t* length)
+{
+  FILE* fp = fopen(path, "rb");
+  if (fp == nullptr) { return nullptr; }
+  fseek(fp, 0, SEEK_END);
+  long len = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  uint8_t* buf = (len > 0) ? (uint8_t*)malloc(len) : nullptr;
+  if (buf && fread(buf, 1, len, fp) != (size_t)len)
+  {
+    free(buf);
+    buf = nullptr;
+  }
+  fclose(fp);
+  *length = len;
+  return buf;
+}
+
+static const lgfx::IFont* load_font_file(const char* path)
+{
+  size_t length = 0;
+  if (has_suffix(path, ".vlw"))
+  {
+    auto buf = load_file(path, &length);
+    if (buf == nullptr) { return nullptr; }
+    static lgfx::PointerWrapper wrapper;
+    static lgfx::VLWfont vlw;
+    wrapper.set(buf, length);
+    return vlw.loadFont(&wrapper) ? &vlw : nullptr;
+  }
+  if (has_suffix(path, ".u8g2"))
+  {
+    auto buf = load_file(path, &length);
+    if (buf == nullptr) { return nullptr; }
+    static lgfx::U8g2font u8g2(buf);
+    return &u8g2;
+  }
+  return nullptr;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    fprintf(stderr, "usage : %s <font> <array name> [first-last ...]\n", argv[0]);
+    return 1;
+  }
+
+  const lgfx::IFont* font = nullptr;
+  for (auto& e : font_table)
+  {
+    if (strcmp(e.name, argv[1]) == 0) { font = e.font; break; }
+  }
+  if (font == nullptr)
+  {
+    font = load_font_file(argv[1]);
+  }
+  if (font == nullptr)
+  {
+    fprintf(stderr, "unknown font : %s\n", argv[1]);
+    return 1;
+  }
+
+  static uint16_t codes[65536];
+  static constexpr size_t max_count = sizeof(codes) / sizeof(codes[0]);
+  size_t count = 0;
+  if (argc == 3)
+  {
+    for (uint32_t c = 0x20; c < 0x7F; ++c) { codes[count++] = c; }
+  }
+  for (int i = 3; i < argc; ++i)
+  {
+    char* end;
+    uint32_t first = strtoul(argv[i], &end, 16);
+    uint32_t last = (*end == '-') ? strtoul(end + 1, nullptr, 16) : first;
+    for (uint32_t c = first; c <= last && c < 0x10000 && count < max_count; ++c) { codes[count++] = c; }
+  }
+
+  size_t length = 0;
+  uint8_t* data = lgfx::AtlasFont::build(font, codes, count, &length);
+  if (data == nullptr)
+  {
+    fprintf(stderr, "build failed\n");
+    return 1;
+  }
+
+  if (!lgfx::AtlasFont::validate(data, length))
+  {
+    fprintf(stderr, "invalid atlas data\n");
+    lgfx::heap_free(data);
+    return 1;
+  }
+
+  auto header = reinterpret_cast<const lgfx::AtlasFont::header_t*>(data);
+  fprintf(stderr, "%s : %u glyphs, %u spans, %u bytes\n", argv[2], header->glyph_count, (unsigned)header->span_count, (unsigned)length);
+
+  printf("#pragma once\n\n// %s", argv[1]);
+  for (int i = 3; i < argc; ++i) { printf(" %s", argv[i]); }
+  printf("\nalignas(4) const uint8_t %s[%u] PROGMEM = {", argv[2], (unsigned)length);
+  for (size_t i = 0; i < length; ++i)
+  {
+    printf("%s0x%02X,", (i & 15) ? " " : "\n  ", data[i]);
+  }
+  printf("\n};\n");
+
+  lgfx::heap_free(data);
+  return 0;
+}
@@ -0,0 +1,247 @@
+// バス通信記録 (Bus_Trace) の解析ツール (PC上で実行する);
+// 記録を Bus_DCS (MIPI-DCSコントローラの模倣) に再生して描画結果(GRAM)をPPMに書き出し、;
+// op毎の所要時間・転送量と、指定したクロック・バス幅での通信時間の見積りを表示する。;
+//
+// usage : LGFXBusTrace <trace.bin> [-o out.ppm] [-w width] [-h height] [-c clock] [-b bus width] [-d other.bin]
+//   -w -h : GRAMの大きさ (省略時 240x320)
+//   -c : 転送時間の見積りに使うクロック (省略時は記録中の setClock の値)
+//   -b : 1:SPI 8:8bitパラレル 16:16bitパラレル (省略時 1)
+//   -d : 別の記録との差分を表示する
+//
+// 記録側では以下のように出力したものをファイルに保存して使用する;
+//   _trace.setBus(&_bus_instance);
+//   _panel_instance.setBus(&_trace);
+//   _trace.beginTrace(1024, [](void*, const uint8_t* data, uint32_t len) { Serial.write(data, len); });
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+
+using namespace lgfx::bus_trace;
+
+static const char* const op_names[op_max] =
+{ "none", "command", "data", "repeat", "bytes", "pixels", "dma_queue", "dma_exec"
+, "begin", "end", "wait", "read_begin", "read", "read_end", "clock", "mark"
+};
+
+struct op_cost_t
+{
+  uint32_t count;
+  uint64_t bytes;
+  uint64_t usec;
+};
+
+struct trace_summary_t
+{
+  op_cost_t ops[op_max];
+  uint32_t commands[256];
+  uint32_t wire_usec;
+  uint32_t total_usec;
+  uint32_t records;
+  bool error;
+};
+
+static bool load_file(const char* path, std::vector<uint8_t>* dst)
+{
+  auto fp = fopen(path, "rb");
+  if (fp == nullptr) { return false; }
+  fseek(fp, 0, SEEK_END);
+  long len = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  dst->resize(len > 0 ? len : 0);
+  bool res = len > 0 && fread(dst->data(), 1, len, fp) == (size_t)len;
+  fclose(fp);
+  return res;
+}
+
+static uint64_t record_bytes(const lgfx::bus_trace_record_t& r)
+{
+  switch (r.op)
+  {
+  case op_command:
+  case op_data:   return (r.bits + 7) >> 3;
+  case op_repeat: return (uint64_t)((r.bits + 7) >> 3) * r.count;
+  default:        return r.length;
+  }
+}
+
+// 記録を集計し、model に再生する。clock を指定した場合はそのクロックで通信時間を見積もる;
+static bool analyze(const std::vector<uint8_t>& data, trace_summary_t* sum, lgfx::Bus_DCS* model, uint32_t clock)
+{
+  memset(sum, 0, sizeof(trace_summary_t));
+  lgfx::bus_trace_reader_t reader;
+  if (!reader.begin(data.data(), data.size())) { return false; }
+
+  // 各記録の所要時間は次の記録までの経過時間とする;
+  lgfx::bus_trace_record_t rec, prev;
+  bool has_prev = false;
+  while (reader.next(&rec))
+  {
+    if (has_prev) { sum->ops[prev.op].usec += rec.delta_usec; }
+    auto& c = sum->ops[rec.op];
+    ++c.count;
+    c.bytes += record_bytes(rec);
+    if (rec.op == op_command) { ++sum->commands[rec.value & 0xFF]; }
+    lgfx::bus_trace_reader_t::replay(rec, model);
+    ++sum->records;
+    sum->total_usec = rec.usec;
+    prev = rec;
+    has_prev = true;
+  }
+  sum->error = reader.hasError();
+  if (clock)
+  { // 記録中の setClock は再生時に反映されるため、再生後に置き換える;
+    auto cfg = model->config();
+    cfg.freq_write = clock;
+    model->config(cfg);
+  }
+  sum->wire_usec = model->getWireUsec();
+  return true;
+}
+
+static void print_summary(const char* name, const trace_summary_t& s, const lgfx::Bus_DCS& model)
+{
+  printf("%s : %u records, %u usec%s\n", name, s.records, s.total_usec, s.error ? " (broken data)" : "");
+  printf("  %-10s %10s %12s %12s\n", "op", "count", "bytes", "usec");
+  for (int op = op_command; op < op_max; ++op)
+  {
+    auto& c = s.ops[op];
+    if (c.count == 0) { continue; }
+    printf("  %-10s %10u %12llu %12llu\n", op_names[op], c.count, (unsigned long long)c.bytes, (unsigned long long)c.usec);
+  }
+  printf("  commands :");
+  for (int i = 0; i < 256; ++i)
+  {
+    if (s.commands[i]) { printf(" %02X:%u", i, s.commands[i]); }
+  }
+  printf("\n");
+  auto& cfg = model.config();
+  printf("  wire : write %llu bytes, read %llu bytes, %u usec (%u bit bus, write %u Hz, read %u Hz)\n"
+        , (unsigned long long)model.getWriteBytes(), (unsigned long long)model.getReadBytes()
+        , s.wire_usec, cfg.bus_width, cfg.freq_write, cfg.freq_read);
+}
+
+static void print_diff(const trace_summary_t& a, const trace_summary_t& b)
+{
+  printf("diff (other - base)\n");
+  printf("  %-10s %10s %12s %12s\n", "op", "count", "bytes", "usec");
+  for (int op = op_command; op < op_max; ++op)
+  {
+    auto& ca = a.ops[op];
+    auto& cb = b.ops[op];
+    if (ca.count == cb.count && ca.bytes == cb.bytes && ca.usec == cb.usec) { continue; }
+    printf("  %-10s %+10lld %+12lld %+12lld\n", op_names[op]
+          , (long long)cb.count - ca.count
+          , (long long)cb.bytes - (long long)ca.bytes
+          , (long long)cb.usec - (long long)ca.usec);
+  }
+  printf("  commands :");
+  for (int i = 0; i < 256; ++i)
+  {
+    if (a.commands[i] != b.commands[i]) { printf(" %02X:%+lld", i, (long long)b.commands[i] - a.commands[i]); }
+  }
+  printf("\n  total usec : %+lld\n", (long long)b.total_usec - (long long)a.total_usec);
+  printf("  wire usec : %+lld\n", (long long)b.wire_usec - (long long)a.wire_usec);
+}
+
+static bool write_ppm(const char* path, const lgfx::Bus_DCS& model)
+{
+  auto fp = fopen(path, "wb");
+  if (fp == nullptr) { return false; }
+  auto& cfg = model.config();
+  size_t len = cfg.memory_width * cfg.memory_height * 3;
+  fprintf(fp, "P6\n%d %d\n255\n", cfg.memory_width, cfg.memory_height);
+  bool res = fwrite(model.getGRAM(), 1, len, fp) == len;
+  fclose(fp);
+  return res;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2)
+  {
+    fprintf(stderr, "usage : %s <trace.bin> [-o out.ppm] [-w width] [-h height] [-c clock] [-b bus width] [-d other.bin]\n", argv[0]);
+    return 1;
+  }
+
+  const char* out_path = nullptr;
+  const char* diff_path = nullptr;
+  int width = 240;
+  int height = 320;
+  int bus_width = 1;
+  uint32_t clock = 0;
+  for (int i = 2; i + 1 < argc; i += 2)
+  {
+    if      (strcmp(argv[i], "-o") == 0) { out_path = argv[i + 1]; }
+    else if (strcmp(argv[i], "-d") == 0) { diff_path = argv[i + 1]; }
+    else if (strcmp(argv[i], "-w") == 0) { width = atoi(argv[i + 1]); }
+    else if (strcmp(argv[i], "-h") == 0) { height = atoi(argv[i + 1]); }
+    else if (strcmp(argv[i], "-c") == 0) { clock = strtoul(argv[i + 1], nullptr, 0); }
+    else if (strcmp(argv[i], "-b") == 0) { bus_width = atoi(argv[i + 1]); }
+    else
+    {
+      fprintf(stderr, "unknown option : %s\n", argv[i]);
+      return 1;
+    }
+  }
+  if (width <= 0 || height <= 0 || width > 65535 || height > 65535)
+  {
+    fprintf(stderr, "invalid size : %d x %d\n", width, height);
+    return 1;
+  }
+  if (bus_width != 1 && bus_width != 8 && bus_width != 16)
+  {
+    fprintf(stderr, "invalid bus width : %d\n", bus_width);
+    return 1;
+  }
+
+  lgfx::Bus_DCS::config_t cfg;
+  cfg.memory_width = width;
+  cfg.memory_height = height;
+  cfg.bus_width = bus_width;
+
+  std::vector<uint8_t> data;
+  if (!load_file(argv[1], &data))
+  {
+    fprintf(stderr, "can't read : %s\n", argv[1]);
+    return 1;
+  }
+
+  lgfx::Bus_DCS model;
+  model.config(cfg);
+  model.init();
+  trace_summary_t base;
+  if (!analyze(data, &base, &model, clock))
+  {
+    fprintf(stderr, "not a bus trace : %s\n", argv[1]);
+    return 1;
+  }
+  print_summary(argv[1], base, model);
+
+  if (out_path && !write_ppm(out_path, model))
+  {
+    fprintf(stderr, "can't write : %s\n", out_path);
+    return 1;
+  }
+
+  if (diff_path)
+  {
+    std::vector<uint8_t> other_data;
+    lgfx::Bus_DCS other_model;
+    other_model.config(cfg);
+    other_model.init();
+    trace_summary_t other;
+    if (!load_file(diff_path, &other_data) || !analyze(other_data, &other, &other_model, clock))
+    {
+      fprintf(stderr, "can't read bus trace : %s\n", diff_path);
+      return 1;
+    }
+    print_summary(diff_path, other, other_model);
+    print_diff(base, other);
+  }
+  return 0;
+}
@@ -0,0 +1,179 @@
+// LGFX_Static (パネルとバスの型をコンパイル時に確定させたデバイス) と LGFX_Device の描画速度の比較 (PC上で実行する);
+// 転送をほとんど行わないバスを用いて、描画関数からバスまでの呼出しにかかる時間を測定する。;
+// 測定内容は TFT_graphicstest_PDQ の testPixels / testLines / testFastLines / testText に準ずる;
+//
+// usage : LGFXStaticBench [repeat count]
+//
+// ※ このバスは同じ翻訳単位にあるため LGFX_Static 側ではバスの処理まで展開されるが、;
+//    実機の Bus_SPI 等では仮想関数の呼出しが直接呼出しに置き換わるのみとなる;
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+
+// 受け取ったデータ量を数えるだけのバス;
+class Bus_Null : public lgfx::IBus
+{
+public:
+  lgfx::bus_type_t busType(void) const override { return lgfx::bus_type_t::bus_spi; }
+  bool init(void) override { return true; }
+  void release(void) override {}
+
+  void beginTransaction(void) override {}
+  void endTransaction(void) override {}
+  void wait(void) override {}
+  bool busy(void) const override { return false; }
+
+  void initDMA(void) override {}
+  void addDMAQueue(const uint8_t*, uint32_t length) override { bytes += length; }
+  void execDMAQueue(void) override {}
+  uint8_t* getDMABuffer(uint32_t length) override { return _flip_buffer.getBuffer(length); }
+
+  void flush(void) override {}
+  bool writeCommand(uint32_t, uint_fast8_t bit_length) override { bytes += bit_length >> 3; return true; }
+  void writeData(uint32_t, uint_fast8_t bit_length) override { bytes += bit_length >> 3; }
+  void writeDataRepeat(uint32_t, uint_fast8_t bit_length, uint32_t count) override { bytes += (bit_length >> 3) * count; }
+  void writePixels(lgfx::pixelcopy_t* pc, uint32_t length) override { bytes += (pc->dst_bits >> 3) * length; }
+  void writeBytes(const uint8_t*, uint32_t length, bool, bool) override { bytes += length; }
+
+  void beginRead(void) override {}
+  void endRead(void) override {}
+  uint32_t readData(uint_fast8_t) override { return 0; }
+  bool readBytes(uint8_t* dst, uint32_t length, bool) override { memset(dst, 0, length); return true; }
+  void readPixels(void* dst, lgfx::pixelcopy_t* pc, uint32_t length) override { memset(dst, 0, (pc->dst_bits >> 3) * length); }
+
+  uint64_t bytes = 0;
+
+private:
+  lgfx::FlipBuffer _flip_buffer;
+};
+
+class LGFX_Dynamic : public lgfx::LGFX_Device
+{
+public:
+  lgfx::Panel_ILI9341 _panel_instance;
+  Bus_Null _bus_instance;
+
+  LGFX_Dynamic(void)
+  {
+    _panel_instance.setBus(&_bus_instance);
+    setPanel(&_panel_instance);
+  }
+};
+
+using LGFX_Fixed = lgfx::LGFX_Static<lgfx::Panel_ILI9341, Bus_Null>;
+
+static uint32_t usec_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename TGFX>
+static uint32_t testPixels(TGFX& tft)
+{
+  auto start = std::chrono::steady_clock::now();
+  int32_t w = tft.width();
+  int32_t h = tft.height();
+  tft.startWrite();
+  for (uint16_t y = 0; y < h; ++y)
+  {
+    for (uint16_t x = 0; x < w; ++x)
+    {
+      tft.drawPixel(x, y, tft.color565(x<<3, y<<3, x*y));
+    }
+  }
+  tft.endWrite();
+  return usec_since(start);
+}
+
+template <typename TGFX>
+static uint32_t testLines(TGFX& tft)
+{
+  auto start = std::chrono::steady_clock::now();
+  int32_t x2 = tft.width() - 1;
+  int32_t y2 = tft.height() - 1;
+  tft.startWrite();
+  for (int32_t x = 0; x <= x2; x += 6) { tft.drawLine(0, 0, x, y2, TFT_CYAN); }
+  for (int32_t y = 0; y <= y2; y += 6) { tft.drawLine(0, 0, x2, y, TFT_CYAN); }
+  for (int32_t x = 0; x <= x2; x += 6) { tft.drawLine(x2, 0, x, y2, TFT_CYAN); }
+  for (int32_t y = 0; y <= y2; y += 6) { tft.drawLine(x2, 0, 0, y, TFT_CYAN); }
+  for (int32_t x = 0; x <= x2; x += 6) { tft.drawLine(0, y2, x, 0, TFT_CYAN); }
+  for (int32_t y = 0; y <= y2; y += 6) { tft.drawLine(0, y2, x2, y, TFT_CYAN); }
+  tft.endWrite();
+  return usec_since(start);
+}
+
+template <typename TGFX>
+static uint32_t testFastLines(TGFX& tft)
+{
+  auto start = std::chrono::steady_clock::now();
+  int32_t w = tft.width();
+  int32_t h = tft.height();
+  tft.startWrite();
+  for (int32_t y = 0; y < h; y += 5) { tft.drawFastHLine(0, y, w, TFT_RED); }
+  for (int32_t x = 0; x < w; x += 5) { tft.drawFastVLine(x, 0, h, TFT_BLUE); }
+  tft.endWrite();
+  return usec_since(start);
+}
+
+template <typename TGFX>
+static uint32_t testText(TGFX& tft)
+{
+  auto start = std::chrono::steady_clock::now();
+  tft.startWrite();
+  tft.setCursor(0, 0);
+  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+  tft.setTextSize(1);
+  for (int i = 0; i < 30; ++i) { tft.println("Hello World! 0123456789"); }
+  tft.endWrite();
+  return usec_since(start);
+}
+
+struct result_t
+{
+  uint32_t usec[4] = { 0 };
+  uint64_t bytes = 0;
+};
+
+template <typename TGFX>
+static void run(TGFX& tft, Bus_Null& bus, int repeat, result_t* res)
+{
+  for (int i = 0; i < repeat; ++i)
+  {
+    res->usec[0] += testPixels(tft);
+    res->usec[1] += testLines(tft);
+    res->usec[2] += testFastLines(tft);
+    res->usec[3] += testText(tft);
+  }
+  res->bytes = bus.bytes;
+}
+
+int main(int argc, char** argv)
+{
+  int repeat = (argc > 1) ? atoi(argv[1]) : 20;
+  if (repeat < 1) { repeat = 1; }
+
+  static LGFX_Dynamic dyn;
+  static LGFX_Fixed fix;
+  dyn.init();
+  fix.init();
+  dyn._bus_instance.bytes = 0;
+  fix.bus_instance().bytes = 0;
+
+  result_t rd, rf;
+  run(dyn, dyn._bus_instance, repeat, &rd);
+  run(fix, fix.bus_instance(), repeat, &rf);
+
+  static const char* const names[] = { "Pixels", "Lines", "Fast Lines", "Text" };
+  printf("%-12s %12s %12s %8s\n", "test", "LGFX_Device", "LGFX_Static", "ratio");
+  for (int i = 0; i < 4; ++i)
+  {
+    printf("%-12s %10u us %10u us %7.2fx\n", names[i], rd.usec[i], rf.usec[i], rf.usec[i] ? (double)rd.usec[i] / rf.usec[i] : 0.0);
+  }
+  printf("bus bytes : %llu / %llu%s\n", (unsigned long long)rd.bytes, (unsigned long long)rf.bytes, rd.bytes == rf.bytes ? "" : " (mismatch)");
+  return rd.bytes == rf.bytes ? 0 : 1;
+}
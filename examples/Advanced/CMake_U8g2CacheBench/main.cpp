@@ -0,0 +1,111 @@
+// U8g2font のグリフキャッシュの効果を測定する (PC上で実行する);
+// 40文字の1行を 10Hz で書き換える表示 (時計や計測値の表示等) を想定し、;
+// 1分間分 (600フレーム) の描画にかかる時間をキャッシュの有無で比較する。;
+//
+// usage : LGFXU8g2CacheBench [font ...]
+//   font : helvR14 / courR14 / lgfxJapanGothic_16 / lgfxJapanGothicP_16 (省略時は全て);
+//
+// ※ 描画先はメモリ上のSprite のため、グリフのデコードと描画処理のみの時間となる;
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+
+#include "adobex11font.h"
+
+static const lgfx::U8g2font helvR14 ( u8g2_font_helvR14_tr );
+static const lgfx::U8g2font courR14 ( u8g2_font_courR14_tr );
+
+struct font_entry_t
+{
+  const char* name;
+  const lgfx::U8g2font* font;
+  bool japanese;
+};
+
+static const font_entry_t font_table[] =
+{ { "helvR14"            , &helvR14                    , false }
+, { "courR14"            , &courR14                    , false }
+, { "lgfxJapanGothic_16" , &fonts::lgfxJapanGothic_16  , true  }
+, { "lgfxJapanGothicP_16", &fonts::lgfxJapanGothicP_16 , true  }
+};
+
+static constexpr int FRAME_RATE = 10;
+static constexpr int FRAMES = FRAME_RATE * 60;
+static constexpr size_t CACHE_BYTES = 8192;
+
+// フレーム毎に一部の文字が変わる40文字の行を作る;
+static void make_line(char* buf, size_t len, int frame, bool japanese)
+{
+  int sec = frame / FRAME_RATE;
+  int temp = 200 + (frame * 7) % 150;
+  if (japanese)
+  { // 全角28文字 + 半角12文字;
+    snprintf(buf, len, "現在時刻%02d時%02d分%02d秒　室温%2d.%d度　湿度%02d％　状態：正常に動作中です。"
+            , 12 + sec / 3600, (sec / 60) % 60, sec % 60, temp / 10, temp % 10, 40 + (frame % 20));
+  }
+  else
+  {
+    snprintf(buf, len, "12:%02d:%02d.%d  Temp %2d.%dC Hum %02d%% Status OK"
+            , (sec / 60) % 60, sec % 60, frame % FRAME_RATE, temp / 10, temp % 10, 40 + (frame % 20));
+  }
+}
+
+static uint32_t run(LGFX_Sprite& sprite, const font_entry_t& entry, uint32_t* max_usec)
+{
+  char line[160];
+  sprite.setFont(entry.font);
+  sprite.setTextColor(TFT_WHITE, TFT_BLACK);
+  *max_usec = 0;
+  uint32_t total = 0;
+  for (int frame = 0; frame < FRAMES; ++frame)
+  {
+    make_line(line, sizeof(line), frame, entry.japanese);
+    auto start = std::chrono::steady_clock::now();
+    sprite.fillRect(0, 0, sprite.width(), sprite.height(), TFT_BLACK);
+    sprite.drawString(line, 0, 4);
+    uint32_t usec = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    total += usec;
+    if (*max_usec < usec) { *max_usec = usec; }
+  }
+  return total;
+}
+
+int main(int argc, char** argv)
+{
+  LGFX_Sprite sprite;
+  sprite.setColorDepth(16);
+  sprite.createSprite(640, 24);
+
+  printf("%d frames (%d Hz x 60 s), 40 characters per frame, cache %u bytes\n", FRAMES, FRAME_RATE, (unsigned)CACHE_BYTES);
+  printf("%-20s %14s %14s %10s %8s %12s\n", "font", "no cache", "cache", "ratio", "load", "cache used");
+  for (auto& entry : font_table)
+  {
+    if (argc > 1)
+    {
+      bool found = false;
+      for (int i = 1; i < argc; ++i) { found |= (strcmp(argv[i], entry.name) == 0); }
+      if (!found) continue;
+    }
+    uint32_t max_nocache, max_cache;
+    lgfx::U8g2font::setGlyphCache(0);
+    uint32_t nocache = run(sprite, entry, &max_nocache);
+    lgfx::U8g2font::setGlyphCache(CACHE_BYTES);
+    uint32_t cache = run(sprite, entry, &max_cache);
+    size_t used = lgfx::U8g2font::getGlyphCacheUsage();
+    lgfx::U8g2font::setGlyphCache(0);
+
+    // load : 10Hz で書き換えた場合に描画が占めるCPU時間の割合 (キャッシュ有効時);
+    printf("%-20s %8.1f us/f %8.1f us/f %9.2fx %7.3f%% %10u B\n", entry.name
+          , (double)nocache / FRAMES, (double)cache / FRAMES
+          , cache ? (double)nocache / cache : 0.0
+          , (double)cache * FRAME_RATE / FRAMES / 10000.0
+          , (unsigned)used);
+    printf("%-20s   max %6u us   max %6u us\n", "", max_nocache, max_cache);
+  }
+  return 0;
+}
@@ -74,6 +74,9 @@ static const lgfx::U8g2font timR24  ( u8g2_font_timR24_tr  );
 void setup()
 {
   lcd.init();
+
+  // 同じ文字を繰り返し描画する場合は、デコード済みグリフのキャッシュを有効にすると速くなる;
+  lgfx::U8g2font::setGlyphCache(8192);
 }
 
 void loop()
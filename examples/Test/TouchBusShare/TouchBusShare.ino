@@ -0,0 +1,74 @@
+#define LGFX_USE_V1
+#include <LovyanGFX.hpp>
+
+#define LGFX_AUTODETECT
+#include <LGFX_AUTODETECT.hpp>  // クラス"LGFX"を準備します
+// #include <lgfx_user/LGFX_ESP32_sample.hpp> // またはユーザ自身が用意したLGFXクラスを準備します
+
+// パネルとタッチが同じバスを共有している場合に、タッチの取得方法によって描画速度がどう変わるかを計測します;
+// mode 0 : タッチを取得しない
+// mode 1 : 毎フレーム getTouch で取得する (DMA転送中でも描画トランザクションを中断する)
+// mode 2 : updateTouch で取得し、getTouchEvent でイベントを受け取る (DMA転送の合間に取得する)
+
+static LGFX lcd;
+static LGFX_Sprite sprite[2];
+
+static constexpr int BAND_HEIGHT = 16;
+static constexpr uint32_t MEASURE_MSEC = 3000;
+
+static size_t draw_frames(int mode)
+{
+  size_t frames = 0;
+  size_t events = 0;
+  uint32_t start = millis();
+  lcd.startWrite();
+  do
+  {
+    for (int y = 0; y < lcd.height(); y += BAND_HEIGHT)
+    {
+      auto &sp = sprite[(y / BAND_HEIGHT) & 1];
+      sp.fillScreen((uint16_t)(frames * 31 + y));
+      sp.pushSprite(0, y);   // DMA転送;
+
+      if (mode == 1)
+      {
+        lgfx::touch_point_t tp;
+        events += lcd.getTouch(&tp, 1);
+      }
+      else if (mode == 2)
+      {
+        lcd.updateTouch();
+        lgfx::touch_event_t ev;
+        while (lcd.getTouchEvent(&ev)) { ++events; }
+      }
+    }
+    ++frames;
+  } while (millis() - start < MEASURE_MSEC);
+  lcd.endWrite();
+
+  Serial.printf("mode %d : %5.1f fps  (touch %u)\r\n", mode, frames * 1000.0f / MEASURE_MSEC, events);
+  return frames;
+}
+
+void setup(void)
+{
+  Serial.begin(115200);
+  lcd.init();
+  lcd.setTouchInterval(10);
+  lcd.setTouchLatency(30);
+
+  for (auto &sp : sprite)
+  {
+    sp.setColorDepth(16);
+    sp.createSprite(lcd.width(), BAND_HEIGHT);
+  }
+}
+
+void loop(void)
+{
+  for (int mode = 0; mode < 3; ++mode)
+  {
+    draw_frames(mode);
+  }
+  Serial.println();
+}
@@ -17,6 +17,7 @@ Contributors:
 /----------------------------------------------------------------------------*/
 
 #include "LGFXBase.hpp"
+#include "LGFX_Sprite.hpp"
 
 #include "../internal/limits.h"
 #include "../utility/miniz.h"
@@ -212,10 +213,20 @@ namespace lgfx
     }
   }
 
+  void LGFXBase::drawPixels(const point16_t* points, uint32_t count)
+  {
+    draw_pixels(points, count, nullptr, nullptr);
+  }
+
   void LGFXBase::drawRect(int32_t x, int32_t y, int32_t w, int32_t h)
   {
     if (_adjust_abs(x, w)||_adjust_abs(y, h)) return;
     startWrite();
+    if (_inside_clip(x, y, x + w - 1, y + h - 1) && _panel->drawRoundRectPreclipped(x, y, w, h, 0, getRawColor(), false))
+    {
+      endWrite();
+      return;
+    }
     writeFastHLine(x, y        , w);
     if (--h) {
       writeFastHLine(x, y + h    , w);
@@ -235,6 +246,11 @@ namespace lgfx
     }
 
     startWrite();
+    if (_inside_clip(x - r, y - r, x + r, y + r) && _panel->drawEllipsePreclipped(x, y, r, r, getRawColor(), false))
+    {
+      endWrite();
+      return;
+    }
     int32_t f = 1 - r;
     int32_t ddF_y = - (r << 1);
     int32_t ddF_x = 1;
@@ -301,6 +317,11 @@ namespace lgfx
 
   void LGFXBase::fillCircle(int32_t x, int32_t y, int32_t r) {
     startWrite();
+    if (r > 0 && _inside_clip(x - r, y - r, x + r, y + r) && _panel->drawEllipsePreclipped(x, y, r, r, getRawColor(), true))
+    {
+      endWrite();
+      return;
+    }
     writeFastHLine(x - r, y, (r << 1) + 1);
     fillCircleHelper(x, y, r, 3, 0);
     endWrite();
@@ -356,6 +377,11 @@ namespace lgfx
     int32_t ry2 = ry * ry;
 
     startWrite();
+    if (_inside_clip(x - rx, y - ry, x + rx, y + ry) && _panel->drawEllipsePreclipped(x, y, rx, ry, getRawColor(), false))
+    {
+      endWrite();
+      return;
+    }
 
     i = -1;
     xt = 0;
@@ -406,6 +432,11 @@ namespace lgfx
     int32_t s;
 
     startWrite();
+    if (_inside_clip(x - rx, y - ry, x + rx, y + ry) && _panel->drawEllipsePreclipped(x, y, rx, ry, getRawColor(), true))
+    {
+      endWrite();
+      return;
+    }
 
     writeFastHLine(x - rx, y, (rx << 1) + 1);
     i = 0;
@@ -437,6 +468,12 @@ namespace lgfx
   {
     if (_adjust_abs(x, w)||_adjust_abs(y, h)) return;
     startWrite();
+    if (r >= 0 && (r << 1) < std::min(w, h) && _inside_clip(x, y, x + w - 1, y + h - 1)
+     && _panel->drawRoundRectPreclipped(x, y, w, h, r, getRawColor(), false))
+    {
+      endWrite();
+      return;
+    }
 
     w--;
     h--;
@@ -482,6 +519,12 @@ namespace lgfx
   {
     if (_adjust_abs(x, w)||_adjust_abs(y, h)) return;
     startWrite();
+    if (r >= 0 && (r << 1) < std::min(w, h) && _inside_clip(x, y, x + w - 1, y + h - 1)
+     && _panel->drawRoundRectPreclipped(x, y, w, h, r, getRawColor(), true))
+    {
+      endWrite();
+      return;
+    }
     int32_t y2 = y + r;
     int32_t y1 = y + h - r - 1;
     int32_t ddF_y = - (r << 1);
@@ -512,85 +555,91 @@ namespace lgfx
 
   void LGFXBase::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
   {
-    bool steep = abs(y1 - y0) > abs(x1 - x0);
-
-    int32_t xstart = _clip_l;
-    int32_t ystart = _clip_t;
-    int32_t xend   = _clip_r;
-    int32_t yend   = _clip_b;
-
-    if (steep)
-    {
-      std::swap(xstart, ystart);
-      std::swap(xend, yend);
-      std::swap(x0, y0);
-      std::swap(x1, y1);
-    }
-    if (x0 > x1)
-    {
-      std::swap(x0, x1);
-      std::swap(y0, y1);
-    }
-    if (x0 > xend || x1 < xstart) return;
-    xend = std::min(x1, xend);
-
-    int32_t dy = abs(y1 - y0);
-    int32_t ystep = (y1 > y0) ? 1 : -1;
-    int32_t dx = x1 - x0;
-    int32_t err = dx >> 1;
-
-    while (x0 < xstart || y0 < ystart || y0 > yend)
+    auto fill = [this](int32_t x, int32_t y, int32_t w, int32_t h) { writeFillRectPreclipped(x, y, w, h); };
+    if (_inside_clip(std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1)))
     {
-      err -= dy;
-      if (err < 0)
+      startWrite();
+      if (!_panel->drawLinePreclipped(x0, y0, x1, y1, getRawColor()))
       {
-        err += dx;
-        y0 += ystep;
+        _draw_line(x0, y0, x1, y1, fill);
       }
-      if (++x0 > xend) return;
+      endWrite();
+      return;
     }
-    int32_t xs = x0;
-    int32_t dlen = 0;
-    if (ystep < 0) std::swap(ystart, yend);
-    yend += ystep;
+    _draw_line(x0, y0, x1, y1, fill);
+  }
 
-    startWrite();
-    if (steep)
+  void LGFXBase::draw_polyline(const point16_t* points, uint32_t count, bool closed)
+  {
+    if (!count) return;
+    if (count == 1) { drawPixel(points[0].x, points[0].y); return; }
+
+    // 区間毎の縦または横の区間を溜めておき、同じ列(行)で接するか重なる区間は1つにまとめて出力する;
+    // (隣り合う線分の共有点もここで重複が除かれる);
+    int32_t rx = 0, ry = 0, rw = 0, rh = 0;
+    auto fill = [&](int32_t x, int32_t y, int32_t w, int32_t h)
     {
-      do
+      if (rw)
       {
-        ++dlen;
-        if ((err -= dy) < 0)
+        if (x == rx && w == rw && y <= ry + rh && ry <= y + h)
         {
-          writeFillRectPreclipped(y0, xs, 1, dlen);
-          err += dx;
-          xs = x0 + 1; dlen = 0; y0 += ystep;
-          if (y0 == yend) break;
+          int32_t b = std::max(ry + rh, y + h);
+          ry = std::min(ry, y);
+          rh = b - ry;
+          return;
         }
-      } while (++x0 <= xend);
-      if (dlen) writeFillRectPreclipped(y0, xs, 1, dlen);
-    }
-    else
-    {
-      do
-      {
-        ++dlen;
-        if ((err -= dy) < 0)
+        if (y == ry && h == rh && x <= rx + rw && rx <= x + w)
         {
-          writeFillRectPreclipped(xs, y0, dlen, 1);
-          err += dx;
-          xs = x0 + 1; dlen = 0; y0 += ystep;
-          if (y0 == yend) break;
+          int32_t r = std::max(rx + rw, x + w);
+          rx = std::min(rx, x);
+          rw = r - rx;
+          return;
         }
-      } while (++x0 <= xend);
-      if (dlen) writeFillRectPreclipped(xs, y0, dlen, 1);
+        writeFillRectPreclipped(rx, ry, rw, rh);
+      }
+      rx = x; ry = y; rw = w; rh = h;
+    };
+
+    // 各頂点の描画範囲に対する位置 (Cohen-Sutherland の領域コード) を求め、範囲外で完結する線分は描画しない;
+    int32_t cl = _clip_l, cr = _clip_r, ct = _clip_t, cb = _clip_b;
+    auto outcode = [cl, cr, ct, cb](int32_t x, int32_t y) -> uint_fast8_t
+    {
+      return (x < cl) | (x > cr) << 1 | (y < ct) << 2 | (y > cb) << 3;
+    };
+
+    startWrite();
+    int32_t x0 = points[0].x;
+    int32_t y0 = points[0].y;
+    uint_fast8_t code0 = outcode(x0, y0);
+    uint32_t last = closed ? count : count - 1;
+    for (uint32_t i = 1; i <= last; ++i)
+    {
+      auto& p = points[i == count ? 0 : i];
+      int32_t x1 = p.x;
+      int32_t y1 = p.y;
+      uint_fast8_t code1 = outcode(x1, y1);
+      if (!(code0 & code1)
+       && (code0 | code1 || !_panel->drawLinePreclipped(x0, y0, x1, y1, getRawColor())))
+      {
+        _draw_line(x0, y0, x1, y1, fill);
+      }
+      x0 = x1;
+      y0 = y1;
+      code0 = code1;
     }
+    if (rw) { writeFillRectPreclipped(rx, ry, rw, rh); }
     endWrite();
   }
 
   void LGFXBase::drawTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
   {
     startWrite();
+    if (_inside_clip(std::min(std::min(x0, x1), x2), std::min(std::min(y0, y1), y2), std::max(std::max(x0, x1), x2), std::max(std::max(y0, y1), y2))
+     && _panel->drawTrianglePreclipped(x0, y0, x1, y1, x2, y2, getRawColor(), false))
+    {
+      endWrite();
+      return;
+    }
     drawLine(x0, y0, x1, y1);
     drawLine(x1, y1, x2, y2);
     drawLine(x2, y2, x0, y0);
@@ -620,6 +669,14 @@ namespace lgfx
       return;
     }
 
+    startWrite();
+    if (_inside_clip(std::min(std::min(x0, x1), x2), y0, std::max(std::max(x0, x1), x2), y2)
+     && _panel->drawTrianglePreclipped(x0, y0, x1, y1, x2, y2, getRawColor(), true))
+    {
+      endWrite();
+      return;
+    }
+
     int32_t dy1 = y1 - y0;
     int32_t dy2 = y2 - y0;
     bool change = ((x1 - x0) * dy2 > (x2 - x0) * dy1);
@@ -641,7 +698,6 @@ namespace lgfx
                  + (xstep2 > 0
                    ? std::min(dx2, dy2)
                    : dx2);
-    startWrite();
     if (y0 != y1) {
       do {
         err1 -= dx1;
@@ -827,6 +883,201 @@ namespace lgfx
     endWrite();
   }
 
+  void LGFXBase::init_smooth_blend(smooth_blend_t* blend, uint32_t rgb888)
+  {
+    setColor(rgb888);
+    blend->pc = create_pc_blend();
+    for (auto& c : blend->buf) { c.raw = rgb888; }
+  }
+
+  void LGFXBase::draw_smooth_pixels(smooth_blend_t* blend, int32_t x, int32_t y, int32_t w)
+  {
+    // 被覆率 0 の画素は描かず、255 の区間は塗り潰し、それ以外の区間を writeImageARGB で背景と合成する;
+    auto buf = blend->buf;
+    int32_t i = 0;
+    do
+    {
+      uint_fast8_t a = buf[i].a;
+      int32_t j = i;
+      if (a == 0)
+      {
+        while (++j < w && buf[j].a == 0);
+      }
+      else if (a == 255)
+      {
+        while (++j < w && buf[j].a == 255);
+        writeFillRectPreclipped(x + i, y, j - i, 1);
+      }
+      else
+      {
+        while (++j < w && buf[j].a != 0 && buf[j].a != 255);
+        auto pc = &blend->pc;
+        pc->src_data = &buf[i];
+        pc->src_x32_add = 1 << pixelcopy_t::FP_SCALE;
+        pc->src_y32_add = 0;
+        pc->src_x32 = 0;
+        pc->src_y32 = 0;
+        _panel->writeImageARGB(x + i, y, j - i, 1, pc);
+      }
+      i = j;
+    } while (i < w);
+  }
+
+  void LGFXBase::draw_wide_line(float x0, float y0, float x1, float y1, float r, uint32_t rgb888)
+  {
+    // 線分からの距離 d の画素の被覆率を r + 0.5 - d とする;
+    // 各行について線分からの距離が閾値以下となる区間 (線分と両端の円の和で、凸なので1つの区間になる) を求め、;
+    // 距離 r - 0.5 以下の区間は塗り潰し、距離 r + 0.5 未満の残りの画素のみ被覆率を計算する;
+    if (!(r > 0.0f)) return;
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float len2 = dx * dx + dy * dy;
+    float len = sqrtf(len2);
+    float ro = r + 0.5f;
+    float ri = r - 0.5f;
+
+    auto span = [&](float py, float t, float& l, float& rr) -> bool
+    {
+      l = INFINITY;
+      rr = -INFINITY;
+      float h = t * t - (py - y0) * (py - y0);
+      if (h >= 0.0f) { h = sqrtf(h); l = x0 - h; rr = x0 + h; }
+      h = t * t - (py - y1) * (py - y1);
+      if (h >= 0.0f) { h = sqrtf(h); l = std::min(l, x1 - h); rr = std::max(rr, x1 + h); }
+      if (len2 > 0.0f)
+      { // 線分の垂線方向の距離が t 以下、かつ線分方向の位置が両端の間にある区間;
+        float cc = -x0 * dy - (py - y0) * dx;
+        float pc = -x0 * dx + (py - y0) * dy;
+        float a = -INFINITY, b = INFINITY;
+        if (dy != 0.0f)
+        {
+          float u = (-t * len - cc) / dy;
+          float v = ( t * len - cc) / dy;
+          a = std::min(u, v);
+          b = std::max(u, v);
+        }
+        else if (fabsf(cc) > t * len) { a = INFINITY; }
+        if (dx != 0.0f)
+        {
+          float u = -pc / dx;
+          float v = (len2 - pc) / dx;
+          a = std::max(a, std::min(u, v));
+          b = std::min(b, std::max(u, v));
+        }
+        else if (pc < 0.0f || pc > len2) { a = INFINITY; }
+        if (a <= b) { l = std::min(l, a); rr = std::max(rr, b); }
+      }
+      return l <= rr;
+    };
+
+    int32_t yt = std::max(_clip_t, (int32_t)ceilf (std::min(y0, y1) - ro));
+    int32_t yb = std::min(_clip_b, (int32_t)floorf(std::max(y0, y1) + ro));
+    if (yt > yb) return;
+
+    smooth_blend_t blend;
+    init_smooth_blend(&blend, rgb888);
+    startWrite();
+    for (int32_t y = yt; y <= yb; ++y)
+    {
+      float l, rr;
+      if (!span(y, ro, l, rr)) continue;
+      int32_t sl = 1, sr = 0;
+      float il, ir;
+      if (ri > 0.0f && span(y, ri, il, ir))
+      {
+        sl = ceilf(il);
+        sr = floorf(ir);
+      }
+      float py = y;
+      _draw_smooth_span(&blend, y, ceilf(l), floorf(rr), sl, sr, [&](int32_t x) -> float
+      {
+        float px = x - x0;
+        float qy = py - y0;
+        float t = (len2 > 0.0f) ? std::min(1.0f, std::max(0.0f, (px * dx + qy * dy) / len2)) : 0.0f;
+        px -= t * dx;
+        qy -= t * dy;
+        return ro - sqrtf(px * px + qy * qy);
+      });
+    }
+    endWrite();
+  }
+
+  void LGFXBase::draw_smooth_arc(int32_t x, int32_t y, float r0, float r1, float angle0, float angle1, uint32_t rgb888)
+  {
+    // 中心からの距離 d の画素の被覆率を min(r1 + 0.5 - d, d - r0 + 0.5) とし、扇形の場合は両端の半径からの距離による被覆率との小さい方を使う;
+    // 各行の左右それぞれで、内側の穴の画素は描かず、円周の場合は完全に覆われる区間を塗り潰す;
+    float span = angle1 - angle0;
+    if (span == 0.0f || !(r1 > 0.0f)) return;
+    bool full = fabsf(span) >= 360.0f;
+    if (!full)
+    {
+      span = fmodf(span, 360.0f);
+      if (span < 0.0f) { span += 360.0f; }
+    }
+    bool narrow = span <= 180.0f;
+    float c0 = cosf(angle0 * deg_to_rad);
+    float s0 = sinf(angle0 * deg_to_rad);
+    float c1 = cosf(angle1 * deg_to_rad);
+    float s1 = sinf(angle1 * deg_to_rad);
+
+    float ro = r1 + 0.5f;
+    float rh = r0 - 0.5f;
+    float so = r1 - 0.5f;
+    float si = r0 + 0.5f;
+    int32_t ir = ceilf(ro);
+    int32_t yt = std::max(_clip_t, y - ir);
+    int32_t yb = std::min(_clip_b, y + ir);
+    if (yt > yb) return;
+
+    smooth_blend_t blend;
+    init_smooth_blend(&blend, rgb888);
+    startWrite();
+    for (int32_t py = yt; py <= yb; ++py)
+    {
+      float fy = py - y;
+      float fy2 = fy * fy;
+      float h = ro * ro - fy2;
+      if (h <= 0.0f) continue;
+      float xo = sqrtf(h);
+      // 穴 (完全に外れる画素) の半幅。穴がない行は -1;
+      float xh = (rh > 0.0f && rh * rh > fy2) ? sqrtf(rh * rh - fy2) : -1.0f;
+      // 完全に覆われる区間の半幅 (si_w ～ so_w)。扇形の場合は使わない;
+      float so_w = -1.0f, si_w = 0.0f;
+      if (full && so > 0.0f && so * so > fy2)
+      {
+        so_w = sqrtf(so * so - fy2);
+        if (si * si > fy2) { si_w = sqrtf(si * si - fy2); }
+      }
+      auto cov = [&](int32_t px) -> float
+      {
+        float fx = px - x;
+        float d = sqrtf(fx * fx + fy2);
+        float c = ro - d;
+        if (r0 > 0.0f) { c = std::min(c, d - rh); }
+        if (!full)
+        {
+          float a0 = c0 * fy - s0 * fx;
+          float a1 = s1 * fx - c1 * fy;
+          c = std::min(c, 0.5f + (narrow ? std::min(a0, a1) : std::max(a0, a1)));
+        }
+        return c;
+      };
+      // 左側 (中心の列を含む) と右側;
+      int32_t xl = ceilf(x - xo);
+      int32_t xr = (xh < 0.0f) ? x : std::min(x, (int32_t)ceilf(x - xh) - 1);
+      int32_t sl = ceilf(x - so_w);
+      int32_t sr = floorf(x - si_w);
+      _draw_smooth_span(&blend, py, xl, xr, sl, sr, cov);
+      xl = (xh < 0.0f) ? x + 1 : std::max(x + 1, (int32_t)floorf(x + xh) + 1);
+      xr = floorf(x + xo);
+      sl = ceilf(x + si_w);
+      sr = floorf(x + so_w);
+      if (sl <= x) { sl = x + 1; }
+      _draw_smooth_span(&blend, py, xl, xr, sl, sr, cov);
+    }
+    endWrite();
+  }
+
   void LGFXBase::draw_gradient_line( int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t colorstart, uint32_t colorend )
   {
     if ( colorstart == colorend || (x0 == x1 && y0 == y1)) {
@@ -917,18 +1168,96 @@ namespace lgfx
     endWrite();
   }
 
-  void LGFXBase::fill_arc_helper(int32_t cx, int32_t cy, int32_t oradius_x, int32_t iradius_x, int32_t oradius_y, int32_t iradius_y, float start, float end)
+  /// sin(0°)～sin(91°) を 1°毎に 1<<14 倍した表;
+  static constexpr int16_t sin_table_q14[92] =
+  {
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,  2845,  3126,
+     3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,  5604,  5872,  6138,  6402,
+     6664,  6924,  7182,  7438,  7692,  7943,  8192,  8438,  8682,  8923,  9162,  9397,
+     9630,  9860, 10087, 10311, 10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982,
+    12176, 12365, 12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296, 15396, 15491,
+    15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083, 16135, 16182, 16225, 16262,
+    16294, 16322, 16344, 16362, 16374, 16382, 16384, 16382,
+  };
+
+  /// angle : 1/256度単位の角度。sin を 1<<14 倍して返す (表の間は線形補間);
+  static int32_t sin_q14(int32_t angle)
+  {
+    angle %= 360 * 256;
+    if (angle < 0) { angle += 360 * 256; }
+    int32_t quadrant = angle / (90 * 256);
+    angle -= quadrant * (90 * 256);
+    if (quadrant & 1) { angle = 90 * 256 - angle; }
+    int32_t i = angle >> 8;
+    int32_t v = sin_table_q14[i] + (((sin_table_q14[i + 1] - sin_table_q14[i]) * (angle & 255)) >> 8);
+    return (quadrant & 2) ? -v : v;
+  }
+
+  /// 除数 d は正;
+  static inline int32_t floor_div(int32_t n, int32_t d)
+  {
+    int32_t q = n / d;
+    return (q * d > n) ? q - 1 : q;
+  }
+
+  /// 扇形の辺。x * s - y * c <= h を満たす x の範囲 (x <= pos または x >= pos) を、行を進める毎に除算なしで求める;
+  struct arc_edge_t
+  {
+    int32_t q, r;   // floor((h + y * c) / d) と余り;
+    int32_t dq, dr; // 1行あたりの増分;
+    int32_t d;
+    int32_t n;      // s == 0 の場合の h + y * c;
+    int32_t c;
+    bool lower;     // true : x <= pos  false : x >= pos;
+
+    void init(int32_t s, int32_t c_, int32_t h, int32_t y)
+    {
+      c = c_;
+      n = h + y * c;
+      lower = s > 0;
+      d = lower ? s : -s;
+      if (d == 0) { q = r = dq = dr = 0; return; }
+      q = floor_div(n, d);
+      r = n - q * d;
+      dq = floor_div(c, d);
+      dr = c - dq * d;
+    }
+
+    void next(void)
+    {
+      if (d == 0) { n += c; return; }
+      q += dq;
+      r += dr;
+      if (r >= d) { r -= d; ++q; }
+    }
+
+    /// 条件を満たす範囲を [lo, hi] で返す;
+    void range(int32_t& lo, int32_t& hi) const
+    {
+      static constexpr int32_t inf = INT16_MAX + 1;
+      if (d == 0)
+      {
+        lo = (n >= 0) ? -inf : inf;
+        hi = (n >= 0) ?  inf : -inf;
+      }
+      else if (lower) { lo = -inf; hi =  q; }
+      else            { lo =  -q;  hi = inf; }
+    }
+  };
+
+  /// 整数 e * e >= n となる最小の e (>= 0) を、前回の値から増減して求める;
+  static inline int32_t ceil_sqrt_step(int32_t e, int32_t n)
   {
-    float s_cos = (cosf(start * deg_to_rad));
-    float e_cos = (cosf(end * deg_to_rad));
-    float sslope = s_cos / (sinf(start * deg_to_rad));
-    float eslope = -1000000;
-    if (end != 360.0) eslope = e_cos / (sinf(end * deg_to_rad));
-    float swidth =  0.5 / s_cos;
-    float ewidth = -0.5 / e_cos;
+    if (n <= 0) return 0;
+    while (e * e < n) { ++e; }
+    while (e > 0 && (e - 1) * (e - 1) >= n) { --e; }
+    return e;
+  }
 
-    bool start180 = !(start < 180);
-    bool end180 = end < 180;
+  void LGFXBase::fill_arc_helper(int32_t cx, int32_t cy, int32_t oradius_x, int32_t iradius_x, int32_t oradius_y, int32_t iradius_y, float start, float end)
+  {
+    // 角度の辺は x * sin - y * cos と半画素 (いずれも 1<<14 倍) の比較、半径は整数の平方比較で、各行の描画範囲を区間として求める;
     bool reversed = start + 180 < end || (end < start && start < end + 180);
 
     int32_t xleft  = -oradius_x;
@@ -942,22 +1271,32 @@ namespace lgfx
       if (     end >= 180 && start >= 180) ye = 0;
       else if (end <  180 && start <  180) y = 0;
     }
-    if (y  < _clip_t - cy    ) y  = _clip_t - cy;
-    if (ye > _clip_b - cy + 1) ye = _clip_b - cy + 1;
-
+    if (y  < _clip_t - cy) y  = _clip_t - cy;
+    if (ye > _clip_b - cy) ye = _clip_b - cy;
     if (xleft  < _clip_l - cx    ) xleft  = _clip_l - cx;
     if (xright > _clip_r - cx + 1) xright = _clip_r - cx + 1;
+    if (y > ye || xleft >= xright) return;
+
+    static constexpr int32_t half = 1 << 13;
+    int32_t sa = start * 256.0f + 0.5f;
+    int32_t ea = end   * 256.0f + 0.5f;
+    arc_edge_t edge_s, edge_e;
+    // 開始側 : x * sin(start) - y * cos(start) <= 0.5;
+    edge_s.init( sin_q14(sa),  sin_q14(sa + 90 * 256), half, y);
+    // 終了側 : x * sin(end) - y * cos(end) > -0.5;
+    edge_e.init(-sin_q14(ea), -sin_q14(ea + 90 * 256), half - 1, y);
 
     bool trueCircle = (oradius_x == oradius_y) && (iradius_x == iradius_y);
 
     int32_t iradius_y2 = iradius_y * (iradius_y - 1);
     int32_t iradius_x2 = iradius_x * (iradius_x - 1);
-    float irad_rate = iradius_x2 && iradius_y2 ? (float)iradius_x2 / (float)iradius_y2 : 0;
+    int64_t irad_rate = iradius_x2 && iradius_y2 ? ((int64_t)iradius_x2 << FP_SCALE) / iradius_y2 : 0;
 
     int32_t oradius_y2 = oradius_y * (oradius_y + 1);
     int32_t oradius_x2 = oradius_x * (oradius_x + 1);
-    float orad_rate = oradius_x2 && oradius_y2 ? (float)oradius_x2 / (float)oradius_y2 : 0;
+    int64_t orad_rate = oradius_x2 && oradius_y2 ? ((int64_t)oradius_x2 << FP_SCALE) / oradius_y2 : 0;
 
+    int32_t xo = 0, xi = 0;
     do
     {
       int32_t y2 = y * y;
@@ -965,43 +1304,116 @@ namespace lgfx
       int32_t compare_i = iradius_y2 - y2;
       if (!trueCircle)
       {
-        compare_i = floorf(compare_i * irad_rate);
-        compare_o = ceilf (compare_o * orad_rate);
+        compare_i = (compare_i * irad_rate) >> FP_SCALE;
+        compare_o = (compare_o * orad_rate + (1 << FP_SCALE) - 1) >> FP_SCALE;
       }
-      int32_t xe = ceilf(sqrtf(compare_o));
-      int32_t x = 1 - xe;
-
-      if ( x < xleft )  x = xleft;
-      if (xe > xright) xe = xright;
-      float ysslope = (y + swidth) * sslope;
-      float yeslope = (y + ewidth) * eslope;
-      int len = 0;
-      do
+      // 半径方向 : xi <= |x| < xo;
+      xo = ceil_sqrt_step(xo, compare_o);
+      xi = ceil_sqrt_step(xi, compare_i);
+
+      // 角度方向 : 開始側と終了側の共通部分 (reversed の場合は和集合);
+      int32_t lo[2], hi[2];
+      edge_s.range(lo[0], hi[0]);
+      edge_e.range(lo[1], hi[1]);
+      int_fast8_t count = 2;
+      if (!reversed)
+      {
+        lo[0] = std::max(lo[0], lo[1]);
+        hi[0] = std::min(hi[0], hi[1]);
+        count = 1;
+      }
+      else
       {
-        bool flg1 = start180 != (x <= ysslope);
-        bool flg2 =   end180 != (x <= yeslope);
-        int32_t x2 = x * x;
-        if (x2 >= compare_i
-         && ((flg1 && flg2) || (reversed && (flg1 || flg2)))
-         && x != xe
-         && x2 < compare_o)
+        if (lo[0] > lo[1]) { std::swap(lo[0], lo[1]); std::swap(hi[0], hi[1]); }
+        if (lo[1] <= hi[0] + 1)
         {
-          ++len;
+          hi[0] = std::max(hi[0], hi[1]);
+          count = 1;
         }
-        else
+      }
+
+      // 穴がある場合は左右の2区間;
+      int32_t rl[2] = { 1 - xo, xi };
+      int32_t rr[2] = { xi ? -xi : xo - 1, xo - 1 };
+      for (int_fast8_t k = 0; k < (xi ? 2 : 1); ++k)
+      {
+        int32_t l0 = std::max(rl[k], xleft);
+        int32_t r0 = std::min(rr[k], xright - 1);
+        for (int_fast8_t j = 0; j < count; ++j)
         {
-          if (len)
-          {
-            writeFastHLine(cx + x - len, cy + y, len);
-            len = 0;
-          }
-          if (x2 >= compare_o) break;
-          if (x < 0 && x2 < compare_i) { x = -x; }
+          int32_t l = std::max(l0, lo[j]);
+          int32_t r = std::min(r0, hi[j]);
+          if (l <= r) { writeFillRectPreclipped(cx + l, cy + y, r - l + 1, 1); }
         }
-      } while (++x <= xe);
+      }
+      edge_s.next();
+      edge_e.next();
     } while (++y <= ye);
   }
 
+  void LGFXBase::draw_pixels(const point16_t* points, uint32_t count, const void* colors, uint32_t (*fp_convert)(const void*, uint32_t, color_conv_t*))
+  {
+    if (!count) return;
+    uint32_t rawcolor = getRawColor();
+    startWrite();
+    bool inside = false;
+    if (colors == nullptr)
+    {
+      int32_t xmin = INT32_MAX, xmax = INT32_MIN, ymin = INT32_MAX, ymax = INT32_MIN;
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        int32_t x = points[i].x;
+        int32_t y = points[i].y;
+        if (xmin > x) { xmin = x; }
+        if (xmax < x) { xmax = x; }
+        if (ymin > y) { ymin = y; }
+        if (ymax < y) { ymax = y; }
+      }
+      inside = _inside_clip(xmin, ymin, xmax, ymax);
+    }
+    if (inside)
+    { // 全ての点が描画範囲内にある場合は配列をそのまま渡す;
+      _panel->drawPixelsPreclipped(points, count, nullptr, rawcolor);
+    }
+    else
+    { // 描画範囲内の点と変換後の色を作業領域に集めてパネルに渡す;
+      static constexpr uint32_t stack_len = 32;
+      static constexpr uint32_t heap_len = 1024;
+      point16_t stack_pts[stack_len];
+      uint32_t stack_raw[stack_len];
+      uint32_t chunk_len = count < heap_len ? count : heap_len;
+      void* buf = (chunk_len > stack_len) ? heap_alloc(chunk_len * (sizeof(point16_t) + (colors ? sizeof(uint32_t) : 0))) : nullptr;
+      auto pts = stack_pts;
+      auto raw = stack_raw;
+      if (buf)
+      {
+        raw = (uint32_t*)buf;
+        pts = (point16_t*)&raw[colors ? chunk_len : 0];
+      }
+      else
+      {
+        chunk_len = stack_len;
+      }
+      uint32_t* rawcolors = colors ? raw : nullptr;
+      uint32_t len = 0;
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        auto& p = points[i];
+        if (p.x < _clip_l || p.x > _clip_r || p.y < _clip_t || p.y > _clip_b) { continue; }
+        pts[len] = p;
+        if (colors) { raw[len] = fp_convert(colors, i, &_write_conv); }
+        if (++len == chunk_len)
+        {
+          _panel->drawPixelsPreclipped(pts, len, rawcolors, rawcolor);
+          len = 0;
+        }
+      }
+      if (len) { _panel->drawPixelsPreclipped(pts, len, rawcolors, rawcolor); }
+      if (buf) { heap_free(buf); }
+    }
+    endWrite();
+  }
+
   void LGFXBase::draw_bitmap(int32_t x, int32_t y, const uint8_t *bitmap, int32_t w, int32_t h, uint32_t fg_rawcolor, uint32_t bg_rawcolor)
   {
     if (w < 1 || h < 1) return;
@@ -1119,10 +1531,94 @@ namespace lgfx
     param->src_y = dy;
 
     startWrite();
-    _panel->writeImage(x, y, dw, dh, param, use_dma);
+    if (_dither == dither_none || !push_image_dither(x, y, dw, dh, param, use_dma))
+    {
+      _panel->writeImage(x, y, dw, dh, param, use_dma);
+    }
     endWrite();
   }
 
+  bool LGFXBase::can_dither(void) const
+  {
+    // 1/2/4bit の出力はグレースケールのパレットのインデックスとして書くため、他の色のパレットではディザを使わない;
+    if (!hasPalette() || (getColorDepth() & color_depth_t::bit_mask) >= 8) return true;
+    auto pal = getPalette();
+    if (pal == nullptr) return false;
+    uint32_t count = getPaletteCount();
+    uint32_t k = 0xFF / (count - 1);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      uint32_t gray = i * k;
+      if (pal[i].r != gray || pal[i].g != gray || pal[i].b != gray) return false;
+    }
+    return true;
+  }
+
+  bool LGFXBase::push_image_dither(int32_t x, int32_t y, int32_t w, int32_t h, pixelcopy_t* param, bool use_dma)
+  {
+    if (!can_dither()) return false;
+    pixelcopy_t pc = *param;
+    if (!pc.set_dither()) return false;
+    // 行列は描画先の座標で引く。PNG のように1行ずつ src_y = 0 で渡される場合も縦方向の模様が揃う;
+    pc.dither_x = x - (int32_t)(pc.src_x32 >> FP_SCALE);
+    pc.dither_y = y - pc.src_y;
+
+    // 誤差拡散は前の行の誤差が必要なため、1行ずつ渡される場合や透過色・変倍がある場合は組織的ディザを使う;
+    if (_dither != dither_diffusion || h == 1
+     || pc.transp != pixelcopy_t::NON_TRANSP
+     || pc.src_x32_add != 1u << FP_SCALE || pc.src_y32_add != 0)
+    {
+      _panel->writeImage(x, y, w, h, &pc, use_dma);
+      return true;
+    }
+
+    size_t line_bytes = (w * pc.dst_bits + 7) >> 3;
+    auto rgb = (bgr888_t*)heap_alloc(w * sizeof(bgr888_t));
+    auto err = (int16_t*)heap_alloc((w + 2) * 3 * sizeof(int16_t));
+    auto buf = (uint8_t*)heap_alloc_dma(line_bytes * 2);
+    if (rgb && err && buf)
+    {
+      pixelcopy_t pc_rgb = *param;
+      pc_rgb.dst_depth = rgb888_3Byte;
+      pc_rgb.fp_copy = (param->src_depth == rgb565_2Byte  ) ? pixelcopy_t::copy_rgb_affine<bgr888_t, swap565_t >
+                     : (param->src_depth == rgb332_1Byte  ) ? pixelcopy_t::copy_rgb_affine<bgr888_t, rgb332_t  >
+                     : (param->src_depth == rgb888_3Byte  ) ? pixelcopy_t::copy_rgb_affine<bgr888_t, bgr888_t  >
+                     : (param->src_depth == rgb666_3Byte  ) ? pixelcopy_t::copy_rgb_affine<bgr888_t, bgr666_t  >
+                                                            : pixelcopy_t::copy_rgb_affine<bgr888_t, bgra8888_t>;
+      pixelcopy_t pc_line(nullptr, pc.dst_depth, pc.dst_depth, hasPalette());
+      uint32_t x_mask = 7 >> (pc_line.src_bits >> 1);
+      pc_line.src_bitwidth = (w + x_mask) & (~x_mask);
+      memset(err, 0, (w + 2) * 3 * sizeof(int16_t));
+
+      uint32_t src_x32 = param->src_x32;
+      int32_t src_y = param->src_y;
+      int32_t i = 0;
+      do
+      {
+        pc_rgb.src_x32 = src_x32;
+        pc_rgb.src_y32 = (src_y + i) << FP_SCALE;
+        pc_rgb.fp_copy(rgb, 0, w, &pc_rgb);
+        auto line = &buf[(i & 1) * line_bytes];
+        pixelcopy_t::diffuse_row(line, rgb, w, err, pc.dst_depth, i & 1);
+        pc_line.src_data = line;
+        pc_line.src_x32 = 0;
+        pc_line.src_y32 = 0;
+        pc_line.src_x32_add = 1 << FP_SCALE;  // 回転したスプライトへの描画で書き換えられるため毎行戻す;
+        pc_line.src_y32_add = 0;
+        _panel->writeImage(x, y + i, w, 1, &pc_line, use_dma);
+      } while (++i < h);
+      _panel->waitDMA();
+    }
+    else
+    {
+      _panel->writeImage(x, y, w, h, &pc, use_dma);
+    }
+    if (buf) heap_free(buf);
+    if (err) heap_free(err);
+    if (rgb) heap_free(rgb);
+    return true;
+  }
+
   void LGFXBase::make_rotation_matrix(float* result, float dst_x, float dst_y, float src_x, float src_y, float angle, float zoom_x, float zoom_y)
   {
     float rad = fmodf(angle, 360) * deg_to_rad;
@@ -1181,6 +1677,12 @@ namespace lgfx
     pc->src_width = w;
     uint32_t x_mask = 7 >> (pc->src_bits >> 1);
     pc->src_bitwidth = (w + x_mask) & (~x_mask);
+    pixelcopy_t pc_post = create_pc_blend();
+    push_image_affine_aa(matrix, pc, &pc_post);
+  }
+
+  pixelcopy_t LGFXBase::create_pc_blend(void)
+  {
     pixelcopy_t pc_post;
     auto dst_depth = getColorDepth();
     pc_post.dst_bits = _write_conv.bits;
@@ -1203,7 +1705,7 @@ namespace lgfx
         pc_post.fp_copy = pixelcopy_t::blend_rgb_fast<rgb332_t>;
       }
     }
-    push_image_affine_aa(matrix, pc, &pc_post);
+    return pc_post;
   }
 
   void LGFXBase::fillAffine(const float matrix[6], int32_t w, int32_t h)
@@ -1267,6 +1769,13 @@ namespace lgfx
 
   void LGFXBase::push_image_affine(const float* matrix, pixelcopy_t* pc)
   {
+    pixelcopy_t pc_dither;
+    if (_dither != dither_none && can_dither())
+    {
+      pc_dither = *pc;
+      if (!pc_dither.set_dither(true)) { pc_dither.fp_copy = nullptr; }
+    }
+
     int32_t min_y = matrix[3] * (pc->src_width  << FP_SCALE);
     int32_t max_y = matrix[4] * (pc->src_height << FP_SCALE);
     if ((min_y < 0) == (max_y < 0))
@@ -1305,6 +1814,27 @@ namespace lgfx
     int32_t cl = _clip_l    ;
     int32_t cr = _clip_r + 1;
 
+    uint8_t* dither_buf = nullptr;
+    if (pc_dither.fp_copy)
+    {
+      dither_buf = (uint8_t*)heap_alloc_dma(((cr - cl) * pc_dither.dst_bits + 7) >> 3);
+      if (dither_buf) { pc = &pc_dither; }
+    }
+
+    // Consecutive rows with the same destination span are converted into a staging buffer
+    // and sent as one band, so that the panel only needs to set the window once per band.
+    // (Only for opaque images, since transparent pixels must not be written.)
+    affine_band_t band;
+    band.add_x = iA[0];
+    band.add_y = iA[3];
+    uint32_t band_max = 0;
+    if (pc->transp == pixelcopy_t::NON_TRANSP && pc->dst_bits >= 8 && !dither_buf)
+    {
+      band_max = std::min<uint32_t>(affine_band_t::MAX_ROWS, max_y - min_y);
+      band.pos = (uint32_t*)alloca(band_max * 2 * sizeof(uint32_t));
+    }
+    uint32_t dst_bytes = pc->dst_bits >> 3;
+
     int32_t y = min_y - max_y;
 
     startWrite();
@@ -1314,24 +1844,146 @@ namespace lgfx
       iA[5] += iA[4];
       int32_t left  = std::max(cl, std::max(iA[0] ? (iA[2] + xs1) / - iA[0] : cl, iA[3] ? (iA[5] + ys1) / - iA[3] : cl));
       int32_t right = std::min(cr, std::min(iA[0] ? (iA[2] + xs2) / - iA[0] : cr, iA[3] ? (iA[5] + ys2) / - iA[3] : cr));
-      if (left < right)
+      uint32_t src_x32 = iA[2] + left * iA[0];
+      uint32_t src_y32 = iA[5] + left * iA[3];
+      bool valid = (left < right)
+                && (static_cast<uint32_t>((int32_t)src_x32 >> FP_SCALE) < pc->src_width)
+                && (static_cast<uint32_t>((int32_t)src_y32 >> FP_SCALE) < pc->src_height);
+      if (band.rows && (!valid || left != band.left || right != band.right || band.rows == band.limit))
       {
-        pc->src_x32 = iA[2] + left * iA[0];
-        if (static_cast<uint32_t>(pc->src_x) < pc->src_width)
+        push_affine_band(&band, pc);
+      }
+      if (!valid) continue;
+      if (band.rows == 0)
+      {
+        band.limit = band_max ? std::min<uint32_t>(band_max, affine_band_t::MAX_BYTES / ((right - left) * dst_bytes)) : 0;
+        if (band.limit < 2)
         {
-          pc->src_y32 = iA[5] + left * iA[3];
-          if (static_cast<uint32_t>(pc->src_y) < pc->src_height)
+          pc->src_x32 = src_x32;
+          pc->src_y32 = src_y32;
+          pc->src_x32_add = band.add_x;
+          pc->src_y32_add = band.add_y;
+          if (dither_buf)
           {
-            pc->src_x32_add = iA[0];
-            pc->src_y32_add = iA[3];
-            _panel->writeImage(left, y + max_y, right - left, 1, pc, true);
+            push_affine_dither_row(left, y + max_y, right - left, pc, dither_buf);
+            continue;
           }
+          _panel->writeImage(left, y + max_y, right - left, 1, pc, true);
+          continue;
         }
+        band.left = left;
+        band.right = right;
+        band.top = y + max_y;
       }
+      band.pos[band.rows * 2    ] = src_x32;
+      band.pos[band.rows * 2 + 1] = src_y32;
+      ++band.rows;
     } while (++y);
+    if (band.rows)
+    {
+      push_affine_band(&band, pc);
+    }
+    if (band.buffer)
+    {
+      _panel->waitDMA();
+      heap_free(band.buffer);
+    }
+    if (dither_buf)
+    {
+      _panel->waitDMA();
+      heap_free(dither_buf);
+    }
     endWrite();
   }
 
+  void LGFXBase::push_affine_dither_row(int32_t x, int32_t y, int32_t w, pixelcopy_t* pc, uint8_t* buf)
+  {
+    // 描画先の座標で行列を引くため、index 0 から始まる行バッファに変換してから不透明な区間ごとに送る;
+    pc->dither_x = x;
+    pc->dither_y = y;
+    pixelcopy_t pc_line(buf, pc->dst_depth, pc->dst_depth, hasPalette());
+    uint32_t x_mask = 7 >> (pc_line.src_bits >> 1);
+    pc_line.src_bitwidth = (w + x_mask) & (~x_mask);
+    pc_line.src_width = w;
+    pc_line.src_height = 1;
+    _panel->waitDMA();
+    int32_t pos = 0;
+    do
+    {
+      int32_t end = pc->fp_copy(buf, pos, w, pc);
+      if (pos != end)
+      {
+        pc_line.src_x32 = pos << FP_SCALE;
+        pc_line.src_y32 = 0;
+        pc_line.src_x32_add = 1 << FP_SCALE;
+        pc_line.src_y32_add = 0;
+        _panel->writeImage(x + pos, y, end - pos, 1, &pc_line, false);
+      }
+      if (end == w) break;
+      pos = pc->fp_skip(end, w, pc);
+    } while (pos != w);
+  }
+
+  void LGFXBase::push_affine_band(affine_band_t* band, pixelcopy_t* pc)
+  {
+    uint32_t rows = band->rows;
+    uint32_t w = band->right - band->left;
+    band->rows = 0;
+    pc->src_x32_add = band->add_x;
+    pc->src_y32_add = band->add_y;
+    if (rows == 1)
+    {
+      pc->src_x32 = band->pos[0];
+      pc->src_y32 = band->pos[1];
+      _panel->writeImage(band->left, band->top, w, 1, pc, true);
+      return;
+    }
+
+    if (band->buffer == nullptr)
+    {
+      band->buffer = (uint8_t*)heap_alloc_dma(affine_band_t::MAX_BYTES * 2);
+      if (band->buffer == nullptr)
+      {
+        for (uint32_t i = 0; i < rows; ++i)
+        {
+          pc->src_x32 = band->pos[i * 2    ];
+          pc->src_y32 = band->pos[i * 2 + 1];
+          pc->src_x32_add = band->add_x;
+          pc->src_y32_add = band->add_y;
+          _panel->writeImage(band->left, band->top + i, w, 1, pc, true);
+        }
+        return;
+      }
+    }
+    // The two halves are used alternately, so that the next band can be converted while the previous one is still being sent by DMA.
+    band->flip = !band->flip;
+    auto buf = &band->buffer[band->flip ? affine_band_t::MAX_BYTES : 0];
+
+    size_t line_bytes = w * (pc->dst_bits >> 3);
+
+    auto dst = buf;
+    for (uint32_t i = 0; i < rows; ++i)
+    {
+      if (i && band->pos[i * 2] == band->pos[i * 2 - 2] && band->pos[i * 2 + 1] == band->pos[i * 2 - 1])
+      { // same source position as the previous row (enlarged image)
+        memcpy(dst, dst - line_bytes, line_bytes);
+      }
+      else
+      {
+        pc->src_x32 = band->pos[i * 2    ];
+        pc->src_y32 = band->pos[i * 2 + 1];
+        pc->fp_copy(dst, 0, w, pc);
+      }
+      dst += line_bytes;
+    }
+
+    pixelcopy_t pc_band(buf, pc->dst_depth, pc->dst_depth, hasPalette());
+    pc_band.src_bitwidth = w;
+    pc_band.src_width = w;
+    pc_band.src_height = rows;
+    _panel->writeImage(band->left, band->top, w, rows, &pc_band, true);
+  }
+
   void LGFXBase::push_image_affine_aa(const float* matrix, pixelcopy_t* pc, pixelcopy_t* pc2)
   {
     int32_t min_y = matrix[3] * (pc->src_width  << FP_SCALE);
@@ -1449,6 +2101,13 @@ namespace lgfx
     int32_t dst_y = src_y + dy;
 
     startWrite();
+    if (dx == 0 && _sx == 0 && _sw == width() && _panel->scrollVertical(_sy, _sh, dy))
+    { // ハードウェアスクロールを使用した場合は空いた範囲の塗り潰しのみ行う;
+      if (     dy > 0) writeFillRectPreclipped(_sx, _sy           , _sw,  dy);
+      else if (dy < 0) writeFillRectPreclipped(_sx, _sy + _sh + dy, _sw, -dy);
+      endWrite();
+      return;
+    }
     _panel->copyRect(dst_x, dst_y, w, h, src_x, src_y);
 
     if (     dx > 0) writeFillRectPreclipped(_sx           , dst_y,  dx, h);
@@ -1947,6 +2606,175 @@ namespace lgfx
     return sumX;
   }
 
+  size_t LGFXBase::drawStringBlended(const char *string, float x, int32_t y, const IFont* font)
+  {
+    if (string == nullptr || string[0] == 0) return 0;
+
+    auto metrics = _font_metrics;
+    if (font == nullptr)
+    {
+      font = _font;
+    }
+    else
+    if (font != _font)
+    {
+      font->getDefaultMetric(&metrics);
+    }
+    int32_t sx = 65536 * _text_style.size_x;
+    int32_t sy = 65536 * _text_style.size_y;
+    int32_t cheight = (metrics.height * sy) >> 16;
+    if (cheight <= 0) return 0;
+    int32_t cwidth = text_width(string, font, &metrics);
+
+    // 1/4ピクセル単位で各文字の位置と描画範囲を求める;
+    int32_t start = -1;
+    int32_t pen = 0;
+    int32_t left = 0;
+    int32_t right = 0;
+    int32_t margin = 1;
+    int32_t glyph_w = 1;
+    auto tmp = string;
+    do {
+      uint16_t uniCode = *tmp;
+      if (_text_style.utf8) {
+        do {
+          uniCode = decodeUTF8(*tmp);
+        } while (uniCode < 0x20 && *++tmp);
+        if (uniCode < 0x20) break;
+      }
+      font->updateFontMetric(&metrics, uniCode);
+      if (start < 0)
+      { // 先頭の文字が左にはみ出す場合は drawString と同様に右へずらす;
+        start = (metrics.x_offset < 0) ? ((- (metrics.x_offset * sx) >> 16) << 2) : 0;
+        pen = start;
+      }
+      int32_t l = std::min<int32_t>(0, metrics.x_offset);
+      int32_t r = std::max<int32_t>(metrics.x_advance, metrics.x_offset + metrics.width);
+      left  = std::min(left , pen + ((l * sx) >> 14));
+      right = std::max(right, pen + ((r * sx) >> 14));
+      margin  = std::max(margin , 1 - ((l * sx) >> 16));
+      glyph_w = std::max(glyph_w, ((r * sx) >> 16) + 1);
+      pen += (metrics.x_advance * sx) >> 14;
+    } while (*(++tmp));
+
+    int32_t qx = (int32_t)floorf(x * 4 + 0.5f);
+    auto datum = _text_style.datum;
+    if (datum & middle_left) {          // vertical: middle
+      y -= cheight >> 1;
+    } else if (datum & bottom_left) {   // vertical: bottom
+      y -= cheight;
+    } else if (datum & baseline_left) { // vertical: baseline
+      y -= (metrics.baseline * sy) >> 16;
+    }
+    if (datum & top_center) {           // Horizontal: middle
+      qx -= (cwidth >> 1) << 2;
+    } else if (datum & top_right) {     // Horizontal: right
+      qx -= cwidth << 2;
+    }
+
+    // 描画範囲をクリップ範囲で切り詰めたものを行バッファとする;
+    int32_t bx = (qx + left) >> 2;
+    int32_t by = y;
+    int32_t bw = ((qx + right + 3) >> 2) + ((qx & 3) != 0) - bx;  // 端数がある場合のみ右に1列はみ出す;
+    int32_t bh = cheight;
+    int32_t cl, ct, cw, ch;
+    getClipRect(&cl, &ct, &cw, &ch);
+    if (bx < cl) { bw -= cl - bx; bx = cl; }
+    if (bw > cl + cw - bx) { bw = cl + cw - bx; }
+    if (by < ct) { bh -= ct - by; by = ct; }
+    if (bh > ct + ch - by) { bh = ct + ch - by; }
+    if (bw <= 0 || bh <= 0) return (pen + 3) >> 2;
+
+    auto cov = (uint16_t*)heap_alloc(bw * bh * sizeof(uint16_t));
+    auto rgb = (bgr888_t*)heap_alloc(bw * bh * sizeof(bgr888_t) + 1);  // bgr888_t::get() reads 4 bytes;
+    LGFX_Sprite glyph;
+    glyph.setColorDepth(rgb888_3Byte);
+    if (!cov || !rgb || !glyph.createSprite(margin + glyph_w, cheight))
+    {
+      if (cov) heap_free(cov);
+      if (rgb) heap_free(rgb);
+      return 0;
+    }
+    memset(cov, 0, bw * bh * sizeof(uint16_t));
+
+    // 各文字を白で描画し、G成分を被覆率として1/4ピクセルずらしながら加算する;
+    TextStyle style = _text_style;
+    style.fore_rgb888 = style.back_rgb888 = 0xFFFFFFu;
+    auto glyph_buf = (const uint8_t*)glyph.getBuffer();
+    int32_t gw = glyph.width();
+    int32_t gy0 = std::max(0, by - y);
+    int32_t gy1 = std::min(cheight, by + bh - y);
+    pen = qx + start;
+    tmp = string;
+    do {
+      uint16_t uniCode = *tmp;
+      if (_text_style.utf8) {
+        do {
+          uniCode = decodeUTF8(*tmp);
+        } while (uniCode < 0x20 && *++tmp);
+        if (uniCode < 0x20) break;
+      }
+      font->updateFontMetric(&metrics, uniCode);
+      int32_t ix = (pen >> 2) - margin - bx;
+      int32_t frac = pen & 3;
+      pen += (metrics.x_advance * sx) >> 14;
+      if (ix >= bw || ix + gw < 0) continue;
+
+      glyph.fillScreen(0);
+      int32_t dummy_filled_x = 0;
+      font->drawChar(&glyph, margin, - ((metrics.y_offset * sy) >> 16), uniCode, &style, &metrics, dummy_filled_x);
+
+      int32_t px0 = std::max(0, -ix);
+      int32_t px1 = std::min(gw, bw - ix);
+      for (int32_t py = gy0; py < gy1; ++py)
+      {
+        auto src = &glyph_buf[(py * gw) * 3 + 1];
+        auto dst = &cov[(py + y - by) * bw];
+        for (int32_t px = px0; px < px1; ++px)
+        {
+          uint32_t c = src[px * 3];
+          if (c == 0) continue;
+          dst[ix + px] += c * (4 - frac);
+          if (frac && ix + px + 1 < bw) { dst[ix + px + 1] += c * frac; }
+        }
+      }
+    } while (*(++tmp));
+    glyph.deleteSprite();
+
+    // 背景と合成して1回で転送する;
+    bool fillbg = (_text_style.back_rgb888 != _text_style.fore_rgb888);
+    this->startWrite();
+    if (!fillbg && isReadable() && !hasPalette())
+    {
+      readRectRGB(bx, by, bw, bh, rgb);
+    }
+    else
+    {
+      uint32_t c = fillbg ? _text_style.back_rgb888 : getBaseColor();
+      bgr888_t back(c >> 16, c >> 8, c);
+      for (int32_t i = 0; i < bw * bh; ++i) { rgb[i] = back; }
+    }
+    int32_t fore_r = (_text_style.fore_rgb888 >> 16) & 0xFF;
+    int32_t fore_g = (_text_style.fore_rgb888 >>  8) & 0xFF;
+    int32_t fore_b = (_text_style.fore_rgb888      ) & 0xFF;
+    for (int32_t i = 0; i < bw * bh; ++i)
+    {
+      uint32_t c = cov[i];
+      if (c == 0) continue;
+      int32_t p = (c >= 1020) ? 256 : ((c * 257) >> 10);
+      auto& d = rgb[i];
+      d.r += ((fore_r - d.r) * p) >> 8;
+      d.g += ((fore_g - d.g) * p) >> 8;
+      d.b += ((fore_b - d.b) * p) >> 8;
+    }
+    pushImage(bx, by, bw, bh, rgb);
+    this->endWrite();
+
+    heap_free(rgb);
+    heap_free(cov);
+    return (pen - qx + 3) >> 2;
+  }
+
   size_t LGFXBase::write(uint8_t utf8)
   {
     if (utf8 == '\r') return 1;
@@ -2595,11 +3423,85 @@ namespace lgfx
   {
     bgra8888_t* lineBuffer;
     pixelcopy_t *pc;
+
+    // for interlaced image
+    lgfx_pngle_draw_callback_t draw_row;
+    uint32_t* passBuffer;  // pass 0-4 の画素 (偶数行・偶数列) を蓄積する;
+    uint32_t* rowBuffer;   // pass 5 で完成させる行;
+    uint32_t width;
+    uint32_t pass_x0;
+    uint32_t pass_x1;
+    uint32_t pass_y0;
+    uint32_t pass_y1;
+    uint32_t next_row;
   };
 
 //-----
 
 
+  // 読み出した背景に argb の画素を合成して転送する ( left から right までの範囲、 argb は div_x 画素毎に並ぶ );
+  static void png_blend_span(png_file_decoder_t* p, int32_t left, int32_t right, int32_t y, uint_fast8_t div_x, const uint8_t* argb)
+  {
+    auto buf = &p->lineBuffer[left];
+    p->gfx->readRect(p->x + left, p->y + y, right - left, 1, buf);
+    auto data = buf;
+    auto end = &p->lineBuffer[right];
+    do
+    {
+      uint_fast8_t a = argb[0];
+      if (a) {
+        if (a == 255) {
+          data->set(*(uint32_t*)argb);
+        } else {
+          uint_fast8_t inv = 255 - a;
+          data->set( (argb[1] * a + data->r * inv + 255) >> 8
+                   , (argb[2] * a + data->g * inv + 255) >> 8
+                   , (argb[3] * a + data->b * inv + 255) >> 8
+                   );
+        }
+      }
+      argb += 4;
+      data += div_x;
+    } while (data < end);
+    p->pc->src_data = buf;
+    p->gfx->pushImage(p->x + left, p->y + y, right - left, 1, p->pc, false);
+  }
+
+  // 半透明の画素の間隔がこれより狭い場合は、1つの範囲として読出し・合成を行う;
+  // ( 範囲を分けると setWindow と読出しコマンドの送信が増えるため、その手間に見合う画素数を目安とする );
+  static constexpr size_t png_alpha_span_gap = 16;
+
+  // 行を 不透明・透明・半透明 の範囲に分け、不透明の範囲はそのまま転送し、半透明の範囲だけを読み出して合成する;
+  static void png_draw_alpha_spans(png_file_decoder_t* p, int32_t x, int32_t y, size_t len, const uint8_t* argb)
+  {
+    size_t i = 0;
+    do
+    {
+      uint_fast8_t a = argb[i * 4];
+      if (a == 0) { continue; }
+      size_t j = i + 1;
+      if (a == 255)
+      {
+        while (j < len && argb[j * 4] == 255) { ++j; }
+        // 短い不透明の範囲の直後に半透明の画素が続く場合は、合成する範囲に含める;
+        if (j == len || argb[j * 4] == 0 || j - i >= png_alpha_span_gap)
+        {
+          p->pc->src_data = &argb[i * 4];
+          p->gfx->pushImage(p->x + x + i, p->y + y, j - i, 1, p->pc, false);
+          i = j - 1;
+          continue;
+        }
+      }
+      for (size_t k = j; k < len && k - j < png_alpha_span_gap; ++k)
+      {
+        a = argb[k * 4];
+        if (a != 0 && a != 255) { j = k + 1; }
+      }
+      png_blend_span(p, x + i, x + j, y, 1, &argb[i * 4]);
+      i = j - 1;
+    } while (++i < len);
+  }
+
   static void png_draw_alpha_callback(void *user_data, uint32_t x, uint32_t y, uint_fast8_t div_x, size_t len, const uint8_t* argb)
   {
     auto p = (png_file_decoder_t*)user_data;
@@ -2641,6 +3543,8 @@ namespace lgfx
     x -= p->offX;
 
     if (!len || (int32_t)x >= p->maxWidth) return;
+    size_t visible = (p->maxWidth - x + div_x - 1) / div_x;
+    if (len > visible) { len = visible; }
 
     size_t idx = 0;
     while ((argb[idx * 4] == 255) && ++idx != len);
@@ -2653,46 +3557,21 @@ namespace lgfx
       {
         p->lineBuffer = (bgra8888_t*)heap_alloc_dma(sizeof(bgra8888_t) * p->maxWidth);
       }
-      p->gfx->readRect(p->x, p->y + y0, p->maxWidth, 1, p->lineBuffer);
-      do
+      if (div_x == 1)
       {
-        uint_fast8_t a = argb[0];
-        if (a) {
-          if (a == 255) {
-            p->lineBuffer[x].set(*(uint32_t*)argb);
-          } else {
-            auto data = &p->lineBuffer[x];
-            uint_fast8_t inv = 255 - a;
-            data->set( (argb[1] * a + data->r * inv + 255) >> 8
-                     , (argb[2] * a + data->g * inv + 255) >> 8
-                     , (argb[3] * a + data->b * inv + 255) >> 8
-                     );
-          }
-        }
-        x += div_x;
-        if ((int32_t)x >= p->maxWidth) break;
-        argb += 4;
-      } while (--len);
-      p->pc->src_data = p->lineBuffer;
-      p->gfx->pushImage(p->x, p->y + y0, p->maxWidth, 1, p->pc, false);
+        png_draw_alpha_spans(p, x, y0, len, argb);
+      }
+      else
+      { // 間引かれた行は、両端の画素の間だけを読み出して合成する;
+        int32_t right = x + (len - 1) * div_x + 1;
+        png_blend_span(p, x, right, y0, div_x, argb);
+      }
     }
     else
-    if (div_x == 1)
-    {
+    { // 間引かれた行 (div_x > 1) は半透明の画素を含む場合だけ届くため、不透明の行は div_x == 1 に限られる;
       p->pc->src_data = argb;
       p->gfx->pushImage(p->x + x, p->y + y0, len, 1, p->pc, false);
     }
-    else
-    {
-      do
-      {
-        p->gfx->setColor(color888(argb[1], argb[2], argb[3]));
-        p->gfx->writeFillRectPreclipped(p->x + x, p->y + y0, 1, 1);
-        x += div_x;
-        if ((int32_t)x >= p->maxWidth) break;
-        argb += 4;
-      } while (--len);
-    }
   }
 
   static void png_draw_alpha_scale_callback(void *user_data, uint32_t x, uint32_t y, uint_fast8_t div_x, size_t len, const uint8_t* argb)
@@ -2737,14 +3616,53 @@ namespace lgfx
     bool hasAlpha = (idx != len);
     if (hasAlpha)
     {
-// ESP_LOGE("TR","alpha:%d", argb[idx * 4 + 3]);
-    //   uint32_t left = idx;
-    //   idx = len;
-    //   while (idx-- && (0 == argb[idx * 4 + 3] || argb[idx * 4 + 3] == 255));
-    //   uint32_t right = idx;
+      while (argb[0] == 0)
+      {
+        argb += 4;
+        x += div_x;
+        if (0 == --len) { return; }
+      }
+      while (argb[(len-1)*4] == 0) { --len; }
+
+      int32_t left = ceilf( x                          * p->zoom_x) - p->offX;
+      if (left < 0) left = 0;
+      int32_t right = ceilf((x + (len - 1) * div_x + 1) * p->zoom_x) - p->offX;
+      if (right > p->maxWidth) right = p->maxWidth;
+      if (left >= right) return;
+
+      // 読み出すのは半透明・透明の画素が掛かる範囲だけとする ( 間引かれた行は画素の隙間にも背景が要るため両端の間を読む );
+      int32_t read_l = left;
+      int32_t read_r = right;
+      if (div_x == 1)
+      {
+        size_t i0 = 0;
+        while (i0 < len && argb[i0 * 4] == 255) { ++i0; }
+        if (i0 == len)
+        {
+          read_r = read_l;
+        }
+        else
+        {
+          size_t i1 = len - 1;
+          while (argb[i1 * 4] == 255) { --i1; }
+          read_l = ceilf((x + i0    ) * p->zoom_x) - p->offX;
+          if (read_l < left) read_l = left;
+          read_r = ceilf((x + i1 + 1) * p->zoom_x) - p->offX;
+          if (read_r > right) read_r = right;
+        }
+      }
+
+      p->pc->src_data = &p->lineBuffer[left];
       do
       {
-        p->gfx->readRect(p->x, p->y + y0, p->maxWidth, 1, p->lineBuffer);
+        if (read_l < read_r)
+        {
+          p->gfx->readRect(p->x + read_l, p->y + y0, read_r - read_l, 1, &p->lineBuffer[read_l]);
+        }
+        else
+        {
+          p->gfx->waitDMA();
+        }
         const uint8_t* argbbuf = argb;
         size_t loop = len;
         size_t xtmp = x;
@@ -2784,14 +3702,17 @@ namespace lgfx
           argbbuf += 4;
           xtmp += div_x;
         } while (--loop);
-        p->gfx->pushImage(p->x, p->y + y0, p->maxWidth, 1, p->pc, true);
+        p->gfx->pushImage(p->x + left, p->y + y0, right - left, 1, p->pc, true);
       } while (++y0 != y1);
+      p->pc->src_data = p->lineBuffer;
     }
     else
-    if (div_x == 1)
     {
 //*  
       p->gfx->waitDMA();
+      // 行は複数回に分けて届くことがあるため、この範囲の画素だけを転送する;
+      int32_t left = p->maxWidth;
+      int32_t right = 0;
       do
       {
         int32_t l = ceilf( x      * p->zoom_x) - p->offX;
@@ -2800,6 +3721,8 @@ namespace lgfx
         if (r > p->maxWidth) r = p->maxWidth;
         if (l < r)
         {
+          if (left > l) left = l;
+          right = r;
           do {
             p->lineBuffer[l].set(*(uint32_t*)argb);
           } while (++l < r);
@@ -2807,9 +3730,12 @@ namespace lgfx
         argb += 4;
         ++x;
       } while (--len);
+      if (left >= right) return;
+      p->pc->src_data = &p->lineBuffer[left];
       do {
-        p->gfx->pushImage(p->x, p->y + y0, p->maxWidth, 1, p->pc, true);
+        p->gfx->pushImage(p->x + left, p->y + y0, right - left, 1, p->pc, true);
       } while (++y0 != y1);
+      p->pc->src_data = p->lineBuffer;
 /*/
       p->pc->src_x32_add = (1 << FP_SCALE) / p->zoom_x;
       p->pc->src_data = argb;
@@ -2822,19 +3748,130 @@ namespace lgfx
       p->pc->src_data = p->lineBuffer;
 //*/
     }
-    else
+  }
+
+  // Adam7 : pass 6 は奇数行を1パスで埋め、偶数行は pass 5 の時点で全ての画素が揃う;
+  // 偶数行・偶数列の画素 (pass 0-4) を蓄積しておき、pass 5 の行と合わせて完成した行を転送する;
+  static bool png_alloc_interlace(png_file_decoder_t* p, uint32_t width, uint32_t height)
+  {
+    // 表示範囲に掛かる画素だけを蓄積する (始点は偶数に揃える);
+    int32_t x0 = (int32_t)floorf(p->offX / p->zoom_x) - 1;
+    int32_t y0 = (int32_t)floorf(p->offY / p->zoom_y) - 1;
+    p->pass_x0 = std::max<int32_t>(0, x0) & ~1u;
+    p->pass_y0 = std::max<int32_t>(0, y0) & ~1u;
+    p->pass_x1 = std::min<uint32_t>(width , ceilf((p->offX + p->maxWidth ) / p->zoom_x) + 1);
+    p->pass_y1 = std::min<uint32_t>(height, ceilf((p->offY + p->maxHeight) / p->zoom_y) + 1);
+    p->next_row = p->pass_y0;
+    p->width = width;
+    if (p->pass_x0 >= p->pass_x1 || p->pass_y0 >= p->pass_y1) { return false; }
+
+    size_t row_len = p->pass_x1 - p->pass_x0;
+    size_t len = ((row_len + 1) >> 1) * ((p->pass_y1 - p->pass_y0 + 1) >> 1) * sizeof(uint32_t);
+    auto buf = (uint32_t*)heap_alloc_psram(len);
+    if (buf == nullptr) { buf = (uint32_t*)heap_alloc(len); }
+    if (buf == nullptr) { return false; }
+    auto row = (uint32_t*)heap_alloc(row_len * sizeof(uint32_t));
+    if (row == nullptr)
+    {
+      heap_free(buf);
+      return false;
+    }
+    memset(buf, 0, len);  // 届かなかった画素は透明として扱う;
+    memset(row, 0, row_len * sizeof(uint32_t));
+    p->passBuffer = buf;
+    p->rowBuffer = row;
+    return true;
+  }
+
+  static void png_flush_interlace_row(png_file_decoder_t* p, uint32_t y)
+  {
+    size_t len = p->pass_x1 - p->pass_x0;
+    auto src = &p->passBuffer[((y - p->pass_y0) >> 1) * ((len + 1) >> 1)];
+    auto row = p->rowBuffer;
+    for (size_t i = 0; i < len; i += 2)
     {
-      size_t h = y1 - y0;
+      row[i] = src[i >> 1];
+    }
+    p->draw_row(p, p->pass_x0, y, 1, len, (const uint8_t*)row);
+    memset(row, 0, len * sizeof(uint32_t));
+    p->next_row = y + 2;
+  }
+
+  // 後続のパスで埋まる範囲をブロックに拡大して描画する;
+  // pass 0:8x8  1:4x8  2:4x4  3:2x4  4:2x2  5:1x2 (半透明の画素を含む場合はそのまま描画する);
+  static void png_draw_progressive(png_file_decoder_t* p, uint32_t x, uint32_t y, uint_fast8_t div_x, size_t len, const uint8_t* argb)
+  {
+    size_t idx = 0;
+    while ((argb[idx * 4] == 255) && ++idx != len);
+    if (idx != len)
+    {
+      p->draw_row(p, x, y, div_x, len, argb);
+      return;
+    }
+
+    uint32_t bw = (x & (div_x - 1)) ? div_x >> 1 : div_x;
+    uint32_t bh = div_x;
+    int32_t t = ceilf( y       * p->zoom_y) - p->offY;
+    if (t < 0) t = 0;
+    int32_t b = ceilf((y + bh) * p->zoom_y) - p->offY;
+    if (b > p->maxHeight) b = p->maxHeight;
+    if (t >= b) return;
+
+    p->data->postRead();
+    if (bw == div_x)
+    { // ブロックが隙間なく並ぶパスは行単位でまとめて転送する;
+      if (p->lineBuffer == nullptr)
+      {
+        p->lineBuffer = (bgra8888_t*)heap_alloc_dma(sizeof(bgra8888_t) * p->maxWidth);
+        if (p->lineBuffer == nullptr) return;
+      }
+      else
+      {
+        p->gfx->waitDMA();
+      }
+      int32_t left = p->maxWidth;
+      int32_t right = 0;
       do
       {
-        int32_t l = ceilf( x      * p->zoom_x) - p->offX;
+        int32_t l = ceilf( x       * p->zoom_x) - p->offX;
         if (l < 0) l = 0;
-        int32_t r = ceilf((x + 1) * p->zoom_x) - p->offX;
+        int32_t r = ceilf((x + bw) * p->zoom_x) - p->offX;
+        if (r > p->maxWidth) r = p->maxWidth;
+        if (l < r)
+        {
+          if (left > l) left = l;
+          right = r;
+          uint32_t argb32 = *(const uint32_t*)argb;
+          do
+          {
+            p->lineBuffer[l].set(argb32);
+          } while (++l < r);
+        }
+        argb += 4;
+        x += div_x;
+      } while (--len);
+      if (left < right)
+      {
+        p->pc->src_data = &p->lineBuffer[left];
+        do
+        {
+          p->gfx->pushImage(p->x + left, p->y + t, right - left, 1, p->pc, false);
+        } while (++t != b);
+      }
+      p->pc->src_data = p->lineBuffer;
+    }
+    else
+    { // 前のパスの画素の間を埋めるパスはブロック単位で塗り潰す;
+      do
+      {
+        int32_t l = ceilf( x       * p->zoom_x) - p->offX;
+        if (l < 0) l = 0;
+        int32_t r = ceilf((x + bw) * p->zoom_x) - p->offX;
         if (r > p->maxWidth) r = p->maxWidth;
         if (l < r)
         {
           p->gfx->setColor(color888(argb[1], argb[2], argb[3]));
-          p->gfx->writeFillRectPreclipped(p->x + l, p->y + y0, r - l, h);
+          p->gfx->writeFillRectPreclipped(p->x + l, p->y + t, r - l, b - t);
         }
         argb += 4;
         x += div_x;
@@ -2842,6 +3879,51 @@ namespace lgfx
     }
   }
 
+  static void png_draw_interlace_callback(void *user_data, uint32_t x, uint32_t y, uint_fast8_t div_x, size_t len, const uint8_t* argb)
+  {
+    auto p = (png_file_decoder_t*)user_data;
+    if (div_x == 1)
+    { // pass 6 : 奇数行はこのパスだけで完成する;
+      p->draw_row(user_data, x, y, div_x, len, argb);
+      return;
+    }
+    if (p->passBuffer == nullptr)
+    {
+      png_draw_progressive(p, x, y, div_x, len, argb);
+      return;
+    }
+
+    bool last = (x + len * div_x >= p->width);
+    if (y < p->pass_y0 || y >= p->pass_y1) return;
+
+    uint32_t x0 = p->pass_x0;
+    uint32_t x1 = p->pass_x1;
+    if (x & 1)
+    { // pass 5 : 偶数行の奇数列。行の末尾が届いた時点でその行が完成する;
+      auto row = p->rowBuffer;
+      do
+      {
+        if (x >= x0 && x < x1) { row[x - x0] = *(const uint32_t*)argb; }
+        argb += 4;
+        x += div_x;
+      } while (--len);
+      if (last)
+      {
+        png_flush_interlace_row(p, y);
+      }
+    }
+    else
+    {
+      auto dst = &p->passBuffer[((y - p->pass_y0) >> 1) * ((x1 - x0 + 1) >> 1)];
+      do
+      {
+        if (x >= x0 && x < x1) { dst[(x - x0) >> 1] = *(const uint32_t*)argb; }
+        argb += 4;
+        x += div_x;
+      } while (--len);
+    }
+  }
+
   bool LGFXBase::draw_png(DataWrapper* data, int32_t x, int32_t y, int32_t maxWidth, int32_t maxHeight, int32_t offX, int32_t offY, float zoom_x, float zoom_y, datum_t datum)
   {
     pngle_t *pngle = lgfx_pngle_new();
@@ -2888,10 +3970,30 @@ namespace lgfx
     // pc.src_data = png.lineBuffer;
 
     png.pc = &pc;
+    png.draw_row = png.zoom_x == 1.0f && png.zoom_y == 1.0f ? png_draw_alpha_callback : png_draw_alpha_scale_callback;
+    png.passBuffer = nullptr;
+    png.rowBuffer = nullptr;
+
+    auto ihdr = lgfx_pngle_get_ihdr(pngle);
+    bool interlaced = ihdr && ihdr->interlace;
+    if (interlaced && _interlace == interlace_final)
+    { // メモリが確保できない場合は interlace_progressive として描画する;
+      png_alloc_interlace(&png, ihdr->width, ihdr->height);
+    }
 
     this->startWrite(!data->hasParent());
 
-    auto res = lgfx_pngle_decomp(pngle, png.zoom_x == 1.0f && png.zoom_y == 1.0f ? png_draw_alpha_callback : png_draw_alpha_scale_callback);
+    auto res = lgfx_pngle_decomp(pngle, interlaced ? png_draw_interlace_callback : png.draw_row);
+
+    if (png.passBuffer) {
+      // pass 5 が無い (幅が1) 場合や途中でデータが途切れた場合は残りの行を描画する;
+      for (uint32_t row = png.next_row; row < png.pass_y1; row += 2)
+      {
+        png_flush_interlace_row(&png, row);
+      }
+      heap_free(png.passBuffer);
+      heap_free(png.rowBuffer);
+    }
 
     this->endWrite();
     if (png.lineBuffer) {
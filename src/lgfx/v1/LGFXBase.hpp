@@ -23,6 +23,8 @@ Contributors:
 
 #include <stdint.h>
 #include <stdarg.h>
+#include <stdlib.h>
+#include <algorithm>
 
 #include "platforms/common.hpp"
 #include "misc/enum.hpp"
@@ -126,6 +128,10 @@ namespace lgfx
                   void drawLine        ( int32_t x0, int32_t y0, int32_t x1, int32_t y1);
     LGFX_INLINE_T void drawTriangle    ( int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, const T& color)  { setColor(color); drawTriangle(x0, y0, x1, y1, x2, y2); }
                   void drawTriangle    ( int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+    LGFX_INLINE_T void drawPolyline    ( const point16_t* points, uint32_t count, const T& color) { setColor(color); drawPolyline(points, count); }
+    LGFX_INLINE   void drawPolyline    ( const point16_t* points, uint32_t count) { draw_polyline(points, count, false); }
+    LGFX_INLINE_T void drawPolygon     ( const point16_t* points, uint32_t count, const T& color) { setColor(color); drawPolygon(points, count); }
+    LGFX_INLINE   void drawPolygon     ( const point16_t* points, uint32_t count) { draw_polyline(points, count, true); }
     LGFX_INLINE_T void fillTriangle    ( int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, const T& color)  { setColor(color); fillTriangle(x0, y0, x1, y1, x2, y2); }
                   void fillTriangle    ( int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
     LGFX_INLINE_T void drawBezier      ( int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, const T& color)  { setColor(color); drawBezier(x0, y0, x1, y1, x2, y2); }
@@ -158,6 +164,15 @@ namespace lgfx
     LGFX_INLINE_T void drawGradientVLine( int32_t x, int32_t y, int32_t h, const T& colorstart, const T& colorend ) { drawGradientLine( x, y, x, y + h - 1, colorstart, colorend ); }
     LGFX_INLINE_T void drawGradientLine ( int32_t x0, int32_t y0, int32_t x1, int32_t y1, const T& colorstart, const T& colorend ) { draw_gradient_line( x0, y0, x1, y1, convert_to_rgb888(colorstart), convert_to_rgb888(colorend) ); }
 
+    /// アンチエイリアスを施した図形 (座標は画素の中心を整数とする)。完全に覆われた画素は通常の塗り潰しで描き、縁の画素のみ背景と合成する;
+    /// r : 線の太さの半分 (両端は半円になる);
+    LGFX_INLINE_T void drawSmoothLine  ( float x0, float y0, float x1, float y1, const T& color ) { draw_wide_line(x0, y0, x1, y1, 0.5f, convert_to_rgb888(color)); }
+    LGFX_INLINE_T void drawWideLine    ( float x0, float y0, float x1, float y1, float r, const T& color ) { draw_wide_line(x0, y0, x1, y1, r, convert_to_rgb888(color)); }
+    LGFX_INLINE_T void drawSmoothCircle( int32_t x, int32_t y, int32_t r, const T& color ) { draw_smooth_arc(x, y, r - 0.5f, r + 0.5f, 0.0f, 360.0f, convert_to_rgb888(color)); }
+    LGFX_INLINE_T void fillSmoothCircle( int32_t x, int32_t y, int32_t r, const T& color ) { draw_wide_line(x, y, x, y, r + 0.5f, convert_to_rgb888(color)); }
+    /// r0, r1 : 内側と外側の半径 (fillArc と同じく順不同)  angle0 から angle1 まで時計回りに描画する;
+    LGFX_INLINE_T void fillSmoothArc   ( int32_t x, int32_t y, int32_t r0, int32_t r1, float angle0, float angle1, const T& color ) { if (r0 > r1) { std::swap(r0, r1); } draw_smooth_arc(x, y, r0 - 0.5f, r1 + 0.5f, angle0, angle1, convert_to_rgb888(color)); }
+
     LGFX_INLINE_T void fillScreen  ( const T& color) { setColor(color); fillRect(0, 0, width(), height()); }
     LGFX_INLINE   void fillScreen  ( void )          {                  fillRect(0, 0, width(), height()); }
 
@@ -179,6 +194,10 @@ namespace lgfx
     LGFX_INLINE   bool isEPD(void) const { return _panel->isEpd(); }
     LGFX_INLINE   bool getSwapBytes(void) const { return _swapBytes; }
     LGFX_INLINE   void setSwapBytes(bool swap) { _swapBytes = swap; }
+    LGFX_INLINE   dither_mode_t getDither(void) const { return _dither; }
+    LGFX_INLINE   void setDither(dither_mode_t mode) { _dither = mode; }
+    LGFX_INLINE   interlace_mode_t getInterlaceMode(void) const { return _interlace; }
+    LGFX_INLINE   void setInterlaceMode(interlace_mode_t mode) { _interlace = mode; }
     LGFX_INLINE   bool isBusShared(void) const { return _panel->isBusShared(); }
     [[deprecated("use isBusShared()")]]
     LGFX_INLINE   bool isSPIShared(void) const { return _panel->isBusShared(); }
@@ -223,6 +242,19 @@ namespace lgfx
       _panel->writeFillRectAlphaPreclipped(x, y, w, h, convert_to_rgb888(color) | alpha << 24 );
     }
 
+    /// 点の配列を描画する。描画範囲外の点を除き、パネルに応じてまとめて描画する。同じ座標の点は後の点の色が残る;
+    /// (色の配列やポインタは下の点毎の色の関数で受ける);
+    template<typename T, typename std::enable_if<!std::is_pointer<T>::value && !std::is_array<T>::value, std::nullptr_t>::type = nullptr>
+    LGFX_INLINE void drawPixels(const point16_t* points, uint32_t count, const T& color) { setColor(color); drawPixels(points, count); }
+                  void drawPixels(const point16_t* points, uint32_t count);
+
+    /// colors : 点毎の色 (points と同じ数);
+    template<typename T>
+    void drawPixels(const point16_t* points, uint32_t count, const T* colors)
+    {
+      draw_pixels(points, count, colors, [](const void* src, uint32_t index, color_conv_t* conv) -> uint32_t { return conv->convert(static_cast<const T*>(src)[index]); });
+    }
+
     LGFX_INLINE_T void drawBitmap (int32_t x, int32_t y, const uint8_t* bitmap, int32_t w, int32_t h, const T& color                    ) { draw_bitmap (x, y, bitmap, w, h, _write_conv.convert(color)); }
     LGFX_INLINE_T void drawBitmap (int32_t x, int32_t y, const uint8_t* bitmap, int32_t w, int32_t h, const T& fgcolor, const T& bgcolor) { draw_bitmap (x, y, bitmap, w, h, _write_conv.convert(fgcolor), _write_conv.convert(bgcolor)); }
     LGFX_INLINE_T void drawXBitmap(int32_t x, int32_t y, const uint8_t* bitmap, int32_t w, int32_t h, const T& color                    ) { draw_xbitmap(x, y, bitmap, w, h, _write_conv.convert(color)); }
@@ -294,6 +326,7 @@ namespace lgfx
     }
 
     void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, pixelcopy_t *param, bool use_dma = false);
+    void pushImageAffine(const float matrix[6], int32_t w, int32_t h, pixelcopy_t *param) { push_image_affine(matrix, w, h, param); }
 
 //----------------------------------------------------------------------------
 
@@ -535,6 +568,10 @@ namespace lgfx
     inline size_t drawString(const char *string, int32_t x, int32_t y                   ) { return draw_string(string, x, y, _text_style.datum); }
     inline size_t drawString(const char *string, int32_t x, int32_t y, const IFont* font) { return draw_string(string, x, y, _text_style.datum, font); }
 
+    /// 文字列全体を行バッファ上でアンチエイリアス合成し、1回の転送で描画する。文字は1/4ピクセル単位で配置する。;
+    /// 背景色を指定していない場合は描画先から背景を一度だけ読み出して合成する (読出し不可・パレット使用時はベースカラー);
+    size_t drawStringBlended(const char *string, float x, int32_t y, const IFont* font = nullptr);
+
     [[deprecated("use IFont")]]
     inline size_t drawNumber(long long_num, int32_t poX, int32_t poY, uint8_t font) { return drawNumber(long_num, poX, poY, fontdata[font]); }
     inline size_t drawNumber(long long_num, int32_t poX, int32_t poY              ) { return drawNumber(long_num, poX, poY, _font         ); }
@@ -564,6 +601,7 @@ namespace lgfx
     inline size_t drawString(const String& string, int32_t x, int32_t y, uint8_t      font) { return draw_string(string.c_str(), x, y, _text_style.datum, fontdata[font]); }
     inline size_t drawString(const String& string, int32_t x, int32_t y, const IFont* font) { return draw_string(string.c_str(), x, y, _text_style.datum,          font ); }
     inline size_t drawString(const String& string, int32_t x, int32_t y                   ) { return draw_string(string.c_str(), x, y, _text_style.datum); }
+    inline size_t drawStringBlended(const String& string, float x, int32_t y, const IFont* font = nullptr) { return drawStringBlended(string.c_str(), x, y, font); }
 
     [[deprecated("use IFont")]] inline size_t drawCentreString(const String& string, int32_t x, int32_t y, uint8_t font) { return draw_string(string.c_str(), x, y, textdatum_t::top_center, fontdata[font]); }
     [[deprecated("use IFont")]] inline size_t drawCenterString(const String& string, int32_t x, int32_t y, uint8_t font) { return draw_string(string.c_str(), x, y, textdatum_t::top_center, fontdata[font]); }
@@ -778,6 +816,8 @@ namespace lgfx
     float _ypivot = 0.0f;   // x pivot point coordinate
 
     bool _swapBytes = false;
+    dither_mode_t _dither = dither_none;
+    interlace_mode_t _interlace = interlace_final;
 
     enum utf8_decode_state_t : uint8_t
     { utf8_state0 = 0
@@ -811,6 +851,12 @@ namespace lgfx
       return (dw <= 0);
     }
 
+    /// 指定範囲が描画範囲内に全て収まっているか;
+    bool _inside_clip(int32_t l, int32_t t, int32_t r, int32_t b) const
+    {
+      return l >= _clip_l && r <= _clip_r && t >= _clip_t && b <= _clip_b;
+    }
+
     bool _clipping(int32_t& x, int32_t& y, int32_t& w, int32_t& h)
     {
       auto cl = _clip_l;
@@ -828,6 +874,124 @@ namespace lgfx
       return true;
     }
 
+    /// drawLine の本体。直線を縦または横に連続する区間に分け、描画範囲内の区間を fill(x, y, w, h) で描く;
+    template <typename TFill>
+    void _draw_line(int32_t x0, int32_t y0, int32_t x1, int32_t y1, TFill fill)
+    {
+      bool steep = abs(y1 - y0) > abs(x1 - x0);
+
+      int32_t xstart = _clip_l;
+      int32_t ystart = _clip_t;
+      int32_t xend   = _clip_r;
+      int32_t yend   = _clip_b;
+
+      if (steep)
+      {
+        std::swap(xstart, ystart);
+        std::swap(xend, yend);
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+      }
+      if (x0 > x1)
+      {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+      }
+      if (x0 > xend || x1 < xstart) return;
+      xend = std::min(x1, xend);
+
+      int32_t dy = abs(y1 - y0);
+      int32_t ystep = (y1 > y0) ? 1 : -1;
+      int32_t dx = x1 - x0;
+      int32_t err = dx >> 1;
+
+      while (x0 < xstart || y0 < ystart || y0 > yend)
+      {
+        err -= dy;
+        if (err < 0)
+        {
+          err += dx;
+          y0 += ystep;
+        }
+        if (++x0 > xend) return;
+      }
+      int32_t xs = x0;
+      int32_t dlen = 0;
+      if (ystep < 0) std::swap(ystart, yend);
+      yend += ystep;
+
+      startWrite();
+      if (steep)
+      {
+        do
+        {
+          ++dlen;
+          if ((err -= dy) < 0)
+          {
+            fill(y0, xs, 1, dlen);
+            err += dx;
+            xs = x0 + 1; dlen = 0; y0 += ystep;
+            if (y0 == yend) break;
+          }
+        } while (++x0 <= xend);
+        if (dlen) fill(y0, xs, 1, dlen);
+      }
+      else
+      {
+        do
+        {
+          ++dlen;
+          if ((err -= dy) < 0)
+          {
+            fill(xs, y0, dlen, 1);
+            err += dx;
+            xs = x0 + 1; dlen = 0; y0 += ystep;
+            if (y0 == yend) break;
+          }
+        } while (++x0 <= xend);
+        if (dlen) fill(xs, y0, dlen, 1);
+      }
+      endWrite();
+    }
+
+    /// アンチエイリアス図形の縁の画素を合成するための作業領域;
+    struct smooth_blend_t
+    {
+      static constexpr int32_t chunk_len = 64;
+      pixelcopy_t pc;
+      argb8888_t buf[chunk_len];
+    };
+    void init_smooth_blend(smooth_blend_t* blend, uint32_t rgb888);
+    void draw_smooth_pixels(smooth_blend_t* blend, int32_t x, int32_t y, int32_t w);
+
+    /// 行 y の xl～xr を描画する。sl～sr は完全に覆われている区間として塗り潰し、それ以外の画素は被覆率 cov(x) (0.0～1.0) に応じて合成する;
+    template <typename TCov>
+    void _draw_smooth_span(smooth_blend_t* blend, int32_t y, int32_t xl, int32_t xr, int32_t sl, int32_t sr, TCov&& cov)
+    {
+      if (xl < _clip_l) { xl = _clip_l; }
+      if (xr > _clip_r) { xr = _clip_r; }
+      if (sl < xl) { sl = xl; }
+      if (sr > xr) { sr = xr; }
+      if (sl > sr) { sl = xr + 1; }
+      while (xl <= xr)
+      {
+        if (xl == sl)
+        {
+          writeFillRectPreclipped(sl, y, sr - sl + 1, 1);
+          xl = sr + 1;
+          continue;
+        }
+        int32_t w = std::min((xl < sl ? sl : xr + 1) - xl, smooth_blend_t::chunk_len);
+        for (int32_t i = 0; i < w; ++i)
+        {
+          float c = cov(xl + i);
+          blend->buf[i].a = c <= 0.0f ? 0 : c >= 1.0f ? 255 : (uint8_t)(c * 255.0f + 0.5f);
+        }
+        draw_smooth_pixels(blend, xl, y, w);
+        xl += w;
+      }
+    }
+
 //----------------------------------------------------------------------------
 
     template<typename T>
@@ -1057,6 +1221,8 @@ namespace lgfx
     }
 
     pixelcopy_t create_pc_gray(const uint8_t *image, lgfx::color_depth_t depth, uint32_t fore_rgb888, uint32_t back_rgb888);
+    /// argb8888_t の1行を描画先と合成する pixelcopy_t を作成する (writeImageARGB 用);
+    pixelcopy_t create_pc_blend(void);
 
 //----------------------------------------------------------------------------
 
@@ -1067,6 +1233,10 @@ namespace lgfx
     void fill_arc_helper(int32_t cx, int32_t cy, int32_t oradius_x, int32_t iradius_x, int32_t oradius_y, int32_t iradius_y, float start, float end);
     void draw_bezier_helper(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
     void draw_bitmap(int32_t x, int32_t y, const uint8_t *bitmap, int32_t w, int32_t h, uint32_t fg_rawcolor, uint32_t bg_rawcolor = ~0u);
+    void draw_pixels(const point16_t* points, uint32_t count, const void* colors, uint32_t (*fp_convert)(const void*, uint32_t, color_conv_t*));
+    void draw_polyline(const point16_t* points, uint32_t count, bool closed);
+    void draw_wide_line(float x0, float y0, float x1, float y1, float r, uint32_t rgb888);
+    void draw_smooth_arc(int32_t x, int32_t y, float r0, float r1, float angle0, float angle1, uint32_t rgb888);
     void draw_xbitmap(int32_t x, int32_t y, const uint8_t *bitmap, int32_t w, int32_t h, uint32_t fg_rawcolor, uint32_t bg_rawcolor = ~0u);
     void push_grayimage(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t *image, color_depth_t depth, uint32_t fg_rgb888, uint32_t bg_rgb888);
     void push_grayimage_rotate_zoom(float dst_x, float dst_y, float src_x, float src_y, float angle, float zoom_x, float zoom_y, int32_t w, int32_t h, const uint8_t* image, color_depth_t depth, uint32_t fg_rgb888, uint32_t bg_rgb888);
@@ -1075,9 +1245,29 @@ namespace lgfx
     void push_image_rotate_zoom_aa(float dst_x, float dst_y, float src_x, float src_y, float angle, float zoom_x, float zoom_y, int32_t w, int32_t h, pixelcopy_t* pc);
     void push_image_affine(const float* matrix, int32_t w, int32_t h, pixelcopy_t *pc);
     void push_image_affine(const float* matrix, pixelcopy_t *pc);
+    bool push_image_dither(int32_t x, int32_t y, int32_t w, int32_t h, pixelcopy_t *pc, bool use_dma);
+    bool can_dither(void) const;
+    void push_affine_dither_row(int32_t x, int32_t y, int32_t w, pixelcopy_t* pc, uint8_t* buf);
     void push_image_affine_aa(const float* matrix, int32_t w, int32_t h, pixelcopy_t *pc);
     void push_image_affine_aa(const float* matrix, pixelcopy_t *pre_pc, pixelcopy_t *post_pc);
 
+    struct affine_band_t
+    {
+      static constexpr uint32_t MAX_ROWS = 32;
+      static constexpr size_t MAX_BYTES = 2048;
+      uint32_t* pos = nullptr;    // source position (src_x32, src_y32) of each row.
+      uint32_t add_x = 0;         // src_x32_add / src_y32_add (a rotated sprite panel rewrites them in writeImage)
+      uint32_t add_y = 0;
+      uint8_t* buffer = nullptr;  // staging buffer (MAX_BYTES * 2)
+      int32_t left = 0;
+      int32_t right = 0;
+      int32_t top = 0;
+      uint32_t rows = 0;
+      uint32_t limit = 0;
+      bool flip = false;
+    };
+    void push_affine_band(affine_band_t* band, pixelcopy_t* pc);
+
     uint16_t decodeUTF8(uint8_t c);
 
     size_t printNumber(unsigned long n, uint8_t base);
@@ -1168,6 +1358,12 @@ namespace lgfx
     inline uint_fast8_t getTouchRaw(touch_point_t *tp, uint_fast8_t count = 1) { return panel()->getTouchRaw(tp, count); }
     inline uint_fast8_t getTouch(touch_point_t *tp, uint_fast8_t count = 1) { return panel()->getTouch(tp, count); }
     inline void convertRawXY(touch_point_t *tp, uint_fast8_t count = 1) { panel()->convertRawXY(tp, count); }
+    inline bool updateTouch(void) { return panel()->updateTouch(); }
+    inline void notifyTouch(void) { panel()->notifyTouch(); }
+    inline bool getTouchEvent(touch_event_t *event) { return panel()->getTouchEvent(event); }
+    inline uint_fast8_t getTouchEventCount(void) const { return panel()->getTouchEventCount(); }
+    inline void setTouchInterval(uint16_t msec) { panel()->setTouchInterval(msec); }
+    inline void setTouchLatency(uint16_t msec) { panel()->setTouchLatency(msec); }
 
     template <typename T>
     uint_fast8_t getTouchRaw(T *x, T *y, uint_fast8_t index = 0)
@@ -0,0 +1,392 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+
+#include "LGFX_CompressedSprite.hpp"
+
+#include <math.h>
+
+#ifdef min
+#undef min
+#endif
+#ifdef max
+#undef max
+#endif
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  static constexpr float deg_to_rad = 0.017453292519943295769236907684886;
+  static constexpr uint32_t FP_SCALE = pixelcopy_t::FP_SCALE;
+
+  // RLE packet : 0x00-0x7F = literal (n+1 pixels follow) / 0x80-0xFF = run ((n&0x7F)+2 copies of the next pixel)
+  static size_t encode_rle_row(uint8_t* dst, const uint8_t* src, uint32_t units, uint_fast8_t unit_bytes)
+  {
+    size_t len = 0;
+    uint32_t i = 0;
+    while (i < units)
+    {
+      uint32_t run = 1;
+      while (i + run < units && run < 129 && 0 == memcmp(&src[(i + run) * unit_bytes], &src[i * unit_bytes], unit_bytes)) { ++run; }
+      if (run > 1)
+      {
+        if (dst)
+        {
+          dst[len] = 0x80 + run - 2;
+          memcpy(&dst[len + 1], &src[i * unit_bytes], unit_bytes);
+        }
+        len += 1 + unit_bytes;
+        i += run;
+        continue;
+      }
+      uint32_t lit = 1;
+      while (i + lit < units && lit < 128
+          && (i + lit + 1 == units || memcmp(&src[(i + lit) * unit_bytes], &src[(i + lit + 1) * unit_bytes], unit_bytes))) { ++lit; }
+      if (dst)
+      {
+        dst[len] = lit - 1;
+        memcpy(&dst[len + 1], &src[i * unit_bytes], lit * unit_bytes);
+      }
+      len += 1 + lit * unit_bytes;
+      i += lit;
+    }
+    return len;
+  }
+
+  bool LGFX_CompressedSprite::row_cache_t::alloc(uint32_t rows, uint32_t row_bytes)
+  {
+    release();
+    if (!rows) return true;
+    buffer = (uint8_t*)heap_alloc(rows * row_bytes + 4);  // bgr888_t::get() reads 4 bytes;
+    tags = (int32_t*)heap_alloc(rows * sizeof(int32_t));
+    if (!buffer || !tags)
+    {
+      release();
+      return false;
+    }
+    memset(tags, 0xFF, rows * sizeof(int32_t));
+    this->rows = rows;
+    return true;
+  }
+
+  void LGFX_CompressedSprite::row_cache_t::release(void)
+  {
+    if (buffer) { heap_free(buffer); buffer = nullptr; }
+    if (tags) { heap_free(tags); tags = nullptr; }
+    rows = 0;
+  }
+
+  bool LGFX_CompressedSprite::createFromSprite(const LGFX_Sprite* sprite)
+  {
+    bool swap = sprite->getRotation() & 1;
+    return createFromBuffer( sprite->getBuffer()
+                           , swap ? sprite->height() : sprite->width()
+                           , swap ? sprite->width() : sprite->height()
+                           , sprite->getColorDepth()
+                           , sprite->getPalette());
+  }
+
+  bool LGFX_CompressedSprite::createFromBuffer(const void* image, int32_t w, int32_t h, color_depth_t depth, const bgr888_t* palette)
+  {
+    deleteSprite();
+    if (image == nullptr || w <= 0 || h <= 0) return false;
+
+    _conv.setColorDepth(depth, palette != nullptr);
+    uint_fast8_t unit_bytes = _conv.bytes ? _conv.bytes : 1;
+    _row_bytes = (((w + _conv.x_mask) & ~(uint32_t)_conv.x_mask) * _conv.bits) >> 3;
+    uint32_t units = _row_bytes / unit_bytes;
+
+    auto src = static_cast<const uint8_t*>(image);
+    size_t len = (h + 1) * sizeof(uint32_t);
+    for (int32_t y = 0; y < h; ++y)
+    {
+      len += encode_rle_row(nullptr, &src[y * _row_bytes], units, unit_bytes);
+    }
+    _data.reset(len, AllocationSource::Normal);
+    if (!_data) return false;
+
+    auto index = reinterpret_cast<uint32_t*>(_data.get());
+    size_t pos = (h + 1) * sizeof(uint32_t);
+    for (int32_t y = 0; y < h; ++y)
+    {
+      index[y] = pos;
+      pos += encode_rle_row(&_data.get()[pos], &src[y * _row_bytes], units, unit_bytes);
+    }
+    index[h] = pos;
+
+    if (_conv.bits <= 8 && (palette || _conv.bits < 8))
+    {
+      size_t count = 1 << _conv.bits;
+      _palette.reset(count * sizeof(bgr888_t) + 1, AllocationSource::Normal);
+      if (!_palette)
+      {
+        deleteSprite();
+        return false;
+      }
+      if (palette)
+      {
+        memcpy(_palette.get(), palette, count * sizeof(bgr888_t));
+      }
+      else
+      { // same as LGFX_Sprite::setPaletteGrayscale
+        uint32_t k = (_conv.bits == 4) ? 0x111111 : (_conv.bits == 2) ? 0x555555 : 0xFFFFFF;
+        for (size_t i = 0; i < count; ++i) { _palette.img24()[i] = i * k; }
+      }
+      _conv.setColorDepth(_conv.depth, true);
+    }
+
+    _data_length = len;
+    _width = w;
+    _height = h;
+    _xpivot = w >> 1;
+    _ypivot = h >> 1;
+    if (_cache_rows) { _cache.alloc(std::min<uint32_t>(_cache_rows, h), _row_bytes); }
+    return true;
+  }
+
+  void LGFX_CompressedSprite::deleteSprite(void)
+  {
+    _cache.release();
+    _data.release();
+    _palette.release();
+    _data_length = 0;
+    _row_bytes = 0;
+    _width = 0;
+    _height = 0;
+  }
+
+  bool LGFX_CompressedSprite::setRowCache(uint32_t rows)
+  {
+    _cache_rows = rows;
+    if (!_data) return true;
+    return _cache.alloc(std::min<uint32_t>(rows, _height), _row_bytes);
+  }
+
+  void LGFX_CompressedSprite::decode_row(uint32_t y, uint8_t* dst) const
+  {
+    uint_fast8_t unit_bytes = _conv.bytes ? _conv.bytes : 1;
+    auto data = _data.get();
+    auto src = &data[reinterpret_cast<const uint32_t*>(data)[y]];
+    auto end = dst + _row_bytes;
+    while (dst < end)
+    {
+      uint_fast8_t c = *src++;
+      if (c & 0x80)
+      {
+        size_t len = (c - 0x7E) * unit_bytes;
+        if (unit_bytes == 1)
+        {
+          memset(dst, *src, len);
+        }
+        else
+        { // 1画素をコピーした後、コピー済みの範囲を倍々に複製する;
+          memcpy(dst, src, unit_bytes);
+          size_t filled = unit_bytes;
+          while (filled < len)
+          {
+            size_t n = std::min(filled, len - filled);
+            memcpy(&dst[filled], dst, n);
+            filled += n;
+          }
+        }
+        src += unit_bytes;
+        dst += len;
+      }
+      else
+      {
+        size_t len = (c + 1) * unit_bytes;
+        memcpy(dst, src, len);
+        src += len;
+        dst += len;
+      }
+    }
+  }
+
+  const uint8_t* LGFX_CompressedSprite::get_row(uint32_t y, row_cache_t* cache, uint8_t* buffer) const
+  {
+    if (cache && cache->rows)
+    {
+      uint32_t slot = y % cache->rows;
+      auto row = &cache->buffer[slot * _row_bytes];
+      if (cache->tags[slot] != (int32_t)y)
+      {
+        decode_row(y, row);
+        cache->tags[slot] = y;
+      }
+      return row;
+    }
+    decode_row(y, buffer);
+    return buffer;
+  }
+
+  void LGFX_CompressedSprite::push_sprite(LovyanGFX* dst, int32_t x, int32_t y, uint32_t transp)
+  {
+    if (!_data || dst == nullptr) return;
+
+    int32_t cx, cy, cw, ch;
+    dst->getClipRect(&cx, &cy, &cw, &ch);
+    if (x >= cx + cw || x + _width <= cx) return;
+    int32_t y0 = std::max(0, cy - y);
+    int32_t y1 = std::min(_height, cy + ch - y);
+    if (y0 >= y1) return;
+
+    // 数行ずつ展開し、2個のバッファを交互に使って転送する;
+    uint32_t rows = std::max<uint32_t>(1, BAND_BYTES / _row_bytes);
+    if (rows > (uint32_t)(y1 - y0)) { rows = y1 - y0; }
+    auto buf = (uint8_t*)heap_alloc_dma(_row_bytes * rows * 2 + 4);
+    if (buf == nullptr) return;
+
+    pixelcopy_t pc(nullptr, dst->getColorDepth(), getColorDepth(), dst->hasPalette(), _palette.get(), transp);
+    dst->startWrite();
+    bool flip = false;
+    do
+    {
+      uint32_t n = std::min<uint32_t>(rows, y1 - y0);
+      auto band = &buf[flip ? _row_bytes * rows : 0];
+      flip = !flip;
+      for (uint32_t i = 0; i < n; ++i)
+      {
+        auto line = &band[i * _row_bytes];
+        auto row = get_row(y0 + i, &_cache, line);
+        if (row != line) { memcpy(line, row, _row_bytes); }
+      }
+      pc.src_data = band;
+      pc.src_x32_add = 1 << FP_SCALE;  // 回転したスプライトへの描画で書き換えられるため毎回戻す;
+      pc.src_y32_add = 0;
+      dst->pushImage(x, y + y0, _width, n, &pc, true);
+      y0 += n;
+    } while (y0 < y1);
+    dst->waitDMA();
+    dst->endWrite();
+    heap_free(buf);
+  }
+
+  void LGFX_CompressedSprite::push_rotate_zoom(LovyanGFX* dst, float x, float y, float angle, float zoom_x, float zoom_y, uint32_t transp)
+  {
+    float rad = fmodf(angle, 360) * deg_to_rad;
+    float sin_f = sinf(rad);
+    float cos_f = cosf(rad);
+    float matrix[6];
+    matrix[0] =  cos_f * zoom_x;
+    matrix[1] = -sin_f * zoom_y;
+    matrix[2] =  (x + 0.5f) - (_xpivot + 0.5f) * matrix[0] - (_ypivot + 0.5f) * matrix[1];
+    matrix[3] =  sin_f * zoom_x;
+    matrix[4] =  cos_f * zoom_y;
+    matrix[5] =  (y + 0.5f) - (_xpivot + 0.5f) * matrix[3] - (_ypivot + 0.5f) * matrix[4];
+    push_affine(dst, matrix, transp);
+  }
+
+  void LGFX_CompressedSprite::push_affine(LovyanGFX* dst, const float matrix[6], uint32_t transp)
+  {
+    if (!_data || dst == nullptr) return;
+
+    // 出力の走査線1本が跨ぐソースの行数。この行数を保持できればキャッシュは走査線ごとに少しずつ入れ替わるだけで済む;
+    uint32_t need = _height;
+    float c = fabsf(matrix[3]);
+    float d = fabsf(matrix[4]);
+    if (d * _height > c * _width)
+    {
+      need = std::min<uint32_t>(_height, (uint32_t)ceilf(_width * c / d) + 2);
+    }
+    row_cache_t tmp;
+    row_cache_t* cache = &_cache;
+    if (_cache.rows < need)
+    {
+      if (tmp.alloc(need, _row_bytes) || (!_cache.rows && tmp.alloc(1, _row_bytes)))
+      {
+        cache = &tmp;
+      }
+      else if (!_cache.rows)
+      {
+        return;
+      }
+    }
+
+    affine_ctx_t ctx { this, cache, pixelcopy_t(nullptr, dst->getColorDepth(), getColorDepth(), dst->hasPalette(), _palette.get(), transp) };
+    pixelcopy_t pc = ctx.pc;
+    pc.fp_copy = copy_affine;
+    pc.fp_skip = skip_affine;
+    pc.src_data = &ctx;
+    pc.no_dither = true;  // 変換は ctx.pc で行うため、ディザ用の関数に差し替えさせない;
+    dst->pushImageAffine(matrix, _width, _height, &pc);
+    tmp.release();
+  }
+
+  uint32_t LGFX_CompressedSprite::copy_affine(void* __restrict dst, uint32_t index, uint32_t last, pixelcopy_t* __restrict param)
+  {
+    auto ctx = static_cast<affine_ctx_t*>(const_cast<void*>(param->src_data));
+    auto pc = &ctx->pc;
+    auto src_y32_add = param->src_y32_add;
+    pc->src_x32_add = param->src_x32_add;
+    pc->src_y32_add = src_y32_add;
+    do
+    {
+      uint32_t y = param->src_y32 >> FP_SCALE;
+      uint32_t end = last;
+      if (src_y32_add)
+      { // 同じソース行を参照する範囲ごとに変換する;
+        uint32_t sy32 = param->src_y32;
+        end = index;
+        do { sy32 += src_y32_add; } while (++end != last && (sy32 >> FP_SCALE) == y);
+      }
+      pc->src_data = ctx->sprite->get_row(y, ctx->cache, nullptr);
+      pc->src_x32 = param->src_x32;
+      pc->src_y32 = param->src_y32 & ((1 << FP_SCALE) - 1);
+      uint32_t res = pc->fp_copy(dst, index, end, pc);
+      param->src_x32 = pc->src_x32;
+      param->src_y32 = (y << FP_SCALE) + pc->src_y32;
+      if (res != end) return res;
+      index = end;
+    } while (index != last);
+    return index;
+  }
+
+  uint32_t LGFX_CompressedSprite::skip_affine(uint32_t index, uint32_t last, pixelcopy_t* param)
+  {
+    auto ctx = static_cast<affine_ctx_t*>(const_cast<void*>(param->src_data));
+    auto pc = &ctx->pc;
+    auto src_y32_add = param->src_y32_add;
+    pc->src_x32_add = param->src_x32_add;
+    pc->src_y32_add = src_y32_add;
+    do
+    {
+      uint32_t y = param->src_y32 >> FP_SCALE;
+      uint32_t end = last;
+      if (src_y32_add)
+      {
+        uint32_t sy32 = param->src_y32;
+        end = index;
+        do { sy32 += src_y32_add; } while (++end != last && (sy32 >> FP_SCALE) == y);
+      }
+      pc->src_data = ctx->sprite->get_row(y, ctx->cache, nullptr);
+      pc->src_x32 = param->src_x32;
+      pc->src_y32 = param->src_y32 & ((1 << FP_SCALE) - 1);
+      uint32_t res = pc->fp_skip(index, end, pc);
+      param->src_x32 = pc->src_x32;
+      param->src_y32 = (y << FP_SCALE) + pc->src_y32;
+      if (res != end) return res;
+      index = end;
+    } while (index != last);
+    return index;
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
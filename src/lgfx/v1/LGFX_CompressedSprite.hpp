@@ -0,0 +1,135 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "LGFX_Sprite.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// 行単位のRLEで圧縮して保持する読み出し専用のスプライト。;
+  /// pushSprite / pushRotateZoom / pushAffine の際に必要な行だけを展開して転送する。;
+  class LGFX_CompressedSprite
+  {
+  public:
+    LGFX_CompressedSprite(LovyanGFX* parent) : _parent(parent) {}
+    LGFX_CompressedSprite(void) : LGFX_CompressedSprite(nullptr) {}
+    LGFX_CompressedSprite(const LGFX_CompressedSprite&) = delete;
+    LGFX_CompressedSprite& operator=(const LGFX_CompressedSprite&) = delete;
+
+    virtual ~LGFX_CompressedSprite(void) { deleteSprite(); }
+
+    /// スプライトの内容を圧縮して取り込む。元のスプライトは削除して構わない。;
+    bool createFromSprite(const LGFX_Sprite* sprite);
+
+    /// 画像データを圧縮して取り込む。1/2/4bitでpaletteを省略した場合はグレースケールとする。;
+    bool createFromBuffer(const void* image, int32_t w, int32_t h, color_depth_t depth, const bgr888_t* palette = nullptr);
+
+    void deleteSprite(void);
+
+    /// 展開済みの行を保持する行数。0の場合は転送の都度展開する。;
+    /// ( 回転・拡縮時は走査線1本が跨ぐ行数分を転送中だけ一時的に確保する );
+    bool setRowCache(uint32_t rows);
+    uint32_t getRowCache(void) const { return _cache_rows; }
+
+    int32_t width(void) const { return _width; }
+    int32_t height(void) const { return _height; }
+    color_depth_t getColorDepth(void) const { return _conv.depth; }
+    bool hasPalette(void) const { return _palette; }
+
+    /// 圧縮後のサイズ (行インデックスを含む);
+    uint32_t bufferLength(void) const { return _data_length; }
+
+    void setPivot(float x, float y) { _xpivot = x; _ypivot = y; }
+    float getPivotX(void) const { return _xpivot; }
+    float getPivotY(void) const { return _ypivot; }
+
+    template<typename T>
+    void pushSprite(                int32_t x, int32_t y, const T& transp) { push_sprite(_parent, x, y, _conv.convert(transp) & _conv.colormask); }
+    template<typename T>
+    void pushSprite(LovyanGFX* dst, int32_t x, int32_t y, const T& transp) { push_sprite(    dst, x, y, _conv.convert(transp) & _conv.colormask); }
+    void pushSprite(                int32_t x, int32_t y) { push_sprite(_parent, x, y); }
+    void pushSprite(LovyanGFX* dst, int32_t x, int32_t y) { push_sprite(    dst, x, y); }
+
+    template<typename T> void pushRotateZoom(                                          float angle, float zoom_x, float zoom_y, const T& transp) { push_rotate_zoom(_parent, _parent->getPivotX(), _parent->getPivotY(), angle, zoom_x, zoom_y, _conv.convert(transp) & _conv.colormask); }
+    template<typename T> void pushRotateZoom(LovyanGFX* dst                          , float angle, float zoom_x, float zoom_y, const T& transp) { push_rotate_zoom(    dst,     dst->getPivotX(),     dst->getPivotY(), angle, zoom_x, zoom_y, _conv.convert(transp) & _conv.colormask); }
+    template<typename T> void pushRotateZoom(                float dst_x, float dst_y, float angle, float zoom_x, float zoom_y, const T& transp) { push_rotate_zoom(_parent,                dst_x,                dst_y, angle, zoom_x, zoom_y, _conv.convert(transp) & _conv.colormask); }
+    template<typename T> void pushRotateZoom(LovyanGFX* dst, float dst_x, float dst_y, float angle, float zoom_x, float zoom_y, const T& transp) { push_rotate_zoom(    dst,                dst_x,                dst_y, angle, zoom_x, zoom_y, _conv.convert(transp) & _conv.colormask); }
+                         void pushRotateZoom(                                          float angle, float zoom_x, float zoom_y)                  { push_rotate_zoom(_parent, _parent->getPivotX(), _parent->getPivotY(), angle, zoom_x, zoom_y); }
+                         void pushRotateZoom(LovyanGFX* dst                          , float angle, float zoom_x, float zoom_y)                  { push_rotate_zoom(    dst,     dst->getPivotX(),     dst->getPivotY(), angle, zoom_x, zoom_y); }
+                         void pushRotateZoom(                float dst_x, float dst_y, float angle, float zoom_x, float zoom_y)                  { push_rotate_zoom(_parent,                dst_x,                dst_y, angle, zoom_x, zoom_y); }
+                         void pushRotateZoom(LovyanGFX* dst, float dst_x, float dst_y, float angle, float zoom_x, float zoom_y)                  { push_rotate_zoom(    dst,                dst_x,                dst_y, angle, zoom_x, zoom_y); }
+
+    template<typename T> void pushAffine(                const float matrix[6], const T& transp) { push_affine(_parent, matrix, _conv.convert(transp) & _conv.colormask); }
+    template<typename T> void pushAffine(LovyanGFX* dst, const float matrix[6], const T& transp) { push_affine(    dst, matrix, _conv.convert(transp) & _conv.colormask); }
+                         void pushAffine(                const float matrix[6])                  { push_affine(_parent, matrix); }
+                         void pushAffine(LovyanGFX* dst, const float matrix[6])                  { push_affine(    dst, matrix); }
+
+  protected:
+
+    struct row_cache_t
+    {
+      uint8_t* buffer = nullptr;
+      int32_t* tags = nullptr;
+      uint32_t rows = 0;
+
+      bool alloc(uint32_t rows, uint32_t row_bytes);
+      void release(void);
+    };
+
+    struct affine_ctx_t
+    {
+      const LGFX_CompressedSprite* sprite;
+      row_cache_t* cache;
+      pixelcopy_t pc;
+    };
+
+    static constexpr uint32_t BAND_BYTES = 2048;  // pushSprite で1回に展開する最大バイト数;
+
+    SpriteBuffer _data;     // uint32_t index[height + 1] + RLE rows
+    SpriteBuffer _palette;
+    row_cache_t _cache;
+    LovyanGFX* _parent;
+    color_conv_t _conv;
+    uint32_t _data_length = 0;
+    uint32_t _row_bytes = 0;
+    uint32_t _cache_rows = 0;
+    int32_t _width = 0;
+    int32_t _height = 0;
+    float _xpivot = 0.0f;
+    float _ypivot = 0.0f;
+
+    const uint8_t* get_row(uint32_t y, row_cache_t* cache, uint8_t* buffer) const;
+    void decode_row(uint32_t y, uint8_t* dst) const;
+
+    void push_sprite(LovyanGFX* dst, int32_t x, int32_t y, uint32_t transp = pixelcopy_t::NON_TRANSP);
+    void push_rotate_zoom(LovyanGFX* dst, float x, float y, float angle, float zoom_x, float zoom_y, uint32_t transp = pixelcopy_t::NON_TRANSP);
+    void push_affine(LovyanGFX* dst, const float matrix[6], uint32_t transp = pixelcopy_t::NON_TRANSP);
+
+    static uint32_t copy_affine(void* __restrict dst, uint32_t index, uint32_t last, pixelcopy_t* __restrict param);
+    static uint32_t skip_affine(uint32_t index, uint32_t last, pixelcopy_t* param);
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
+
+using LGFX_CompressedSprite = lgfx::LGFX_CompressedSprite;
@@ -73,8 +73,102 @@ namespace lgfx
     }
   }
 
+  static inline uint32_t load_be32(const uint8_t* src)
+  {
+    uint32_t v;
+    memcpy(&v, src, 4);
+    return getSwap32(v);
+  }
+
+  static inline void store_be32(uint8_t* dst, uint32_t v)
+  {
+    v = getSwap32(v);
+    memcpy(dst, &v, 4);
+  }
+
+  /// Copy a run of packed pixels between MSB-first bit rows (1/2/4bpp). src and dst must not overlap.
+  static void copy_bits(uint8_t* __restrict dst, uint32_t dst_bit, const uint8_t* __restrict src, uint32_t src_bit, uint32_t len)
+  {
+    dst += dst_bit >> 3;
+    dst_bit &= 7;
+    src += src_bit >> 3;
+    src_bit &= 7;
+
+    if (dst_bit == src_bit)
+    { // same alignment : partial head byte, whole bytes, partial tail byte.
+      if (dst_bit)
+      {
+        uint32_t mask = 0xFF >> dst_bit;
+        if (len < 8 - dst_bit)
+        {
+          mask &= ~(0xFF >> (dst_bit + len));
+          *dst = (*dst & ~mask) | (*src & mask);
+          return;
+        }
+        *dst = (*dst & ~mask) | (*src & mask);
+        ++dst;
+        ++src;
+        len -= 8 - dst_bit;
+      }
+      memcpy(dst, src, len >> 3);
+      if (len & 7)
+      {
+        uint32_t mask = (uint8_t)~(0xFF >> (len & 7));
+        dst += len >> 3;
+        src += len >> 3;
+        *dst = (*dst & ~mask) | (*src & mask);
+      }
+      return;
+    }
+
+    // different alignment : the source is shifted and merged.
+    if (dst_bit)
+    { // fill up the head byte of dst.
+      uint32_t n = std::min<uint32_t>(8 - dst_bit, len);
+      uint32_t v = *src << 8;
+      if (src_bit + n > 8) { v |= src[1]; }
+      v = (v << src_bit) >> (8 + dst_bit);         // source bits aligned to dst_bit.
+      uint32_t mask = (0xFF >> dst_bit) & ~(0xFF >> (dst_bit + n));
+      *dst = (*dst & ~mask) | (v & mask);
+      ++dst;
+      src_bit += n;
+      src += src_bit >> 3;
+      src_bit &= 7;
+      len -= n;
+      if (!src_bit)
+      {
+        copy_bits(dst, 0, src, 0, len);
+        return;
+      }
+    }
+
+    uint32_t lshift = src_bit;
+    uint32_t rshift = 8 - src_bit;
+    while (len >= 32)
+    { // 32 pixels (1bpp) per step. the 5 source bytes read here are all part of the run.
+      store_be32(dst, (load_be32(src) << lshift) | (src[4] >> rshift));
+      dst += 4;
+      src += 4;
+      len -= 32;
+    }
+    while (len >= 8)
+    {
+      *dst++ = (src[0] << lshift) | (src[1] >> rshift);
+      ++src;
+      len -= 8;
+    }
+    if (len)
+    {
+      uint32_t v = src[0] << lshift;
+      if (src_bit + len > 8) { v |= src[1] >> rshift; }
+      uint32_t mask = (uint8_t)~(0xFF >> len);
+      *dst = (*dst & ~mask) | (v & mask);
+    }
+  }
+
   void Panel_Sprite::setBuffer(void* buffer, int32_t w, int32_t h, color_conv_t* conv)
   {
+    _modified = true;
     deleteSprite();
 
     _img.reset(buffer);
@@ -97,6 +191,7 @@ namespace lgfx
 
   void* Panel_Sprite::createSprite(int32_t w, int32_t h, color_conv_t* conv, bool psram)
   {
+    _modified = true;
     if (w < 1 || h < 1)
     {
       deleteSprite();
@@ -166,6 +261,7 @@ namespace lgfx
 
   void Panel_Sprite::drawPixelPreclipped(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor)
   {
+    _modified = true;
     uint_fast8_t r = _rotation;
     if (r)
     {
@@ -199,8 +295,57 @@ namespace lgfx
     }
   }
 
+  template <typename T>
+  static void store_points(T* dst, const point16_t* points, uint32_t count, const uint32_t* rawcolors, uint32_t rawcolor, int32_t base, int32_t dx, int32_t dy)
+  {
+    if (rawcolors)
+    {
+      for (uint32_t i = 0; i < count; ++i) { dst[base + points[i].x * dx + points[i].y * dy] = rawcolors[i]; }
+    }
+    else
+    {
+      T c;
+      c = rawcolor;
+      for (uint32_t i = 0; i < count; ++i) { dst[base + points[i].x * dx + points[i].y * dy] = c; }
+    }
+  }
+
+  void Panel_Sprite::drawPixelsPreclipped(const point16_t* points, uint32_t count, const uint32_t* rawcolors, uint32_t rawcolor)
+  {
+    if (!count) return;
+    _modified = true;
+
+    // 回転を反映した座標からバッファ上の位置への変換を index = base + x * dx + y * dy の形にまとめる;
+    uint_fast8_t r = _rotation;
+    int32_t bw = _bitwidth;
+    int32_t dx = 1, dy = 1, bx = 0, by = 0;
+    if ((1u << r) & 0b10010110) { dy = -1; by = _height - 1; }
+    if (r & 2)                  { dx = -1; bx = _width  - 1; }
+    if (r & 1) { dx *= bw; bx *= bw; }
+    else       { dy *= bw; by *= bw; }
+    int32_t base = bx + by;
+
+    auto bits = _write_bits;
+    if (bits >= 8)
+    {
+      if (bits == 8)       { store_points(_img.img8() , points, count, rawcolors, rawcolor, base, dx, dy); }
+      else if (bits == 16) { store_points(_img.img16(), points, count, rawcolors, rawcolor, base, dx, dy); }
+      else                 { store_points(_img.img24(), points, count, rawcolors, rawcolor, base, dx, dy); }
+      return;
+    }
+    auto img = _img.img8();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      uint32_t index = (base + points[i].x * dx + points[i].y * dy) * bits;
+      uint8_t* dst = &img[index >> 3];
+      uint8_t mask = (uint8_t)(~(0xFF >> bits)) >> (index & 7);
+      *dst = (*dst & ~mask) | ((rawcolors ? rawcolors[i] : rawcolor) & mask);
+    }
+  }
+
   void Panel_Sprite::writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
   {
+    _modified = true;
     uint_fast8_t r = _rotation;
     if (r)
     {
@@ -305,6 +450,7 @@ namespace lgfx
 
   void Panel_Sprite::writeBlock(uint32_t rawcolor, uint32_t length)
   {
+    _modified = true;
     do
     {
       uint32_t h = 1;
@@ -358,6 +504,7 @@ namespace lgfx
 
   void Panel_Sprite::writePixels(pixelcopy_t* param, uint32_t length, bool use_dma)
   {
+    _modified = true;
     (void)use_dma;
     uint_fast16_t xs = _xs;
     uint_fast16_t xe = _xe;
@@ -462,6 +609,7 @@ namespace lgfx
 
   void Panel_Sprite::writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool)
   {
+    _modified = true;
     uint_fast8_t r = _rotation;
     if (r == 0 && param->transp == pixelcopy_t::NON_TRANSP && param->no_convert && _img.use_memcpy())
     {
@@ -473,7 +621,26 @@ namespace lgfx
         uint_fast8_t mask = (bits == 1) ? 7
                           : (bits == 2) ? 3
                                         : 1;
-        flg_memcpy = (sx & mask) == (x & mask) && (w == this->_panel_width || 0 == (w & mask));
+        flg_memcpy = 0 == ((sx | x) & mask) && (w == this->_panel_width || 0 == (w & mask));
+        if (!flg_memcpy)
+        { // packed pixels at any bit position : copied row by row with shift-merge.
+          auto bw = _bitwidth * bits >> 3;
+          auto dst = &_img[bw * y];
+          auto sw = param->src_bitwidth * bits >> 3;
+          auto src = &((const uint8_t*)param->src_data)[param->src_y * sw];
+          uint32_t sb = sx * bits;
+          uint32_t len = w * bits;
+          size_t row_len = ((sb & 7) + len + 7) >> 3;
+          auto buf = (uint8_t*)alloca(row_len);
+          do
+          {
+            memcpy_P(buf, &src[sb >> 3], row_len);  // the source may be in flash.
+            copy_bits(dst, x * bits, buf, sb & 7, len);
+            dst += bw;
+            src += sw;
+          } while (--h);
+          return;
+        }
       }
       if (flg_memcpy)
       {
@@ -522,6 +689,7 @@ namespace lgfx
 
   void Panel_Sprite::writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param)
   {
+    _modified = true;
     uint32_t nextx = 0;
     uint32_t nexty = 1 << pixelcopy_t::FP_SCALE;
     if (_rotation)
@@ -641,6 +809,7 @@ namespace lgfx
 
   void Panel_Sprite::copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y)
   {
+    _modified = true;
     uint_fast8_t r = _rotation;
     if (r)
     {
@@ -650,35 +819,34 @@ namespace lgfx
     }
 
     if (_write_bits < 8) {
-      pixelcopy_t param(_img, _write_depth, _write_depth);
-      param.src_bitwidth = _bitwidth;
-      int32_t add_y = (src_y < dst_y) ? -1 : 1;
+      uint32_t bits = _write_bits;
+      int32_t add = (_bitwidth * bits) >> 3;
+      uint32_t len = w * bits;
+      uint32_t src_bit = src_x * bits;
+      uint32_t dst_bit = dst_x * bits;
+      if (src_y < dst_y) {
+        src_y += h - 1;
+        dst_y += h - 1;
+        add = -add;
+      }
+      uint8_t* src = &_img[src_y * abs(add)];
+      uint8_t* dst = &_img[dst_y * abs(add)];
       if (src_y != dst_y) {
-        if (src_y < dst_y) {
-          src_y += h - 1;
-          dst_y += h - 1;
-        }
-        param.src_y = src_y;
         do
         {
-          param.src_x = src_x;
-          auto idx = dst_x + dst_y * _bitwidth;
-          param.fp_copy(_img, idx, idx + w, &param);
-          dst_y += add_y;
-          param.src_y += add_y;
+          copy_bits(dst, dst_bit, src, src_bit, len);
+          src += add;
+          dst += add;
         } while (--h);
       } else {
-        size_t len = (_bitwidth * _write_bits) >> 3;
-        auto buf = (uint8_t*)alloca(len);
-        param.src_data = buf;
-        param.src_y32 = 0;
+        // the same row : the source run is taken out first, because it overlaps with the destination.
+        size_t row_len = ((src_bit & 7) + len + 7) >> 3;
+        auto buf = (uint8_t*)alloca(row_len);
         do {
-          memcpy(buf, &_img[src_y * len], len);
-          param.src_x = src_x;
-          auto idx = dst_x + dst_y * _bitwidth;
-          param.fp_copy(_img, idx, idx + w, &param);
-          dst_y += add_y;
-          src_y += add_y;
+          memcpy(buf, &src[src_bit >> 3], row_len);
+          copy_bits(dst, dst_bit, buf, src_bit & 7, len);
+          src += add;
+          dst += add;
         } while (--h);
       }
     }
@@ -714,6 +882,142 @@ namespace lgfx
     }
   }
 
+//----------------------------------------------------------------------------
+
+  static void mipmap_reduce(argb8888_t* __restrict dst, const argb8888_t* __restrict s0, const argb8888_t* __restrict s1, uint32_t src_w)
+  {
+    uint32_t x = 0;
+    do
+    {
+      uint32_t x1 = (x + 1 < src_w) ? x + 1 : x;
+      const argb8888_t* c[4] = { &s0[x], &s0[x1], &s1[x], &s1[x1] };
+      uint32_t a = 0, r = 0, g = 0, b = 0;
+      for (size_t i = 0; i < 4; ++i)
+      {
+        uint32_t ca = c[i]->a;
+        a += ca;
+        r += c[i]->r * ca;
+        g += c[i]->g * ca;
+        b += c[i]->b * ca;
+      }
+      if (a)
+      {
+        dst->set((a + 2) >> 2, r / a, g / a, b / a);
+      }
+      else
+      {
+        dst->set(0);
+      }
+      ++dst;
+    } while ((x += 2) < src_w);
+  }
+
+  bool LGFX_Sprite::update_mipmap(uint32_t transp)
+  {
+    if (_mipmap_levels && !_panel_sprite._modified && _mipmap_transp == transp) return true;
+
+    uint32_t w = _panel_sprite._panel_width;
+    uint32_t h = _panel_sprite._panel_height;
+    if (w < 2 && h < 2) return false;
+
+    uint_fast8_t levels = 0;
+    size_t total = 0;
+    for (uint32_t lw = w, lh = h; (lw > 1 || lh > 1) && levels < MIPMAP_MAX_LEVEL; ++levels)
+    {
+      lw = (lw + 1) >> 1;
+      lh = (lh + 1) >> 1;
+      total += lw * lh;
+    }
+
+    if (_mipmap_levels != levels || !_mipmap)
+    {
+      _mipmap_levels = 0;
+      _mipmap.reset(total * sizeof(argb8888_t), _psram ? AllocationSource::Psram : AllocationSource::Normal);
+      if (!_mipmap) return false;
+    }
+    SpriteBuffer rows(w * 2 * sizeof(argb8888_t), AllocationSource::Normal);
+    if (!rows) return false;
+
+    // level 1 : the sprite image is converted to argb8888 two rows at a time (transparent color becomes alpha 0).
+    auto pc = create_pc_antialias(_img, _palette.img24(), getColorDepth(), transp);
+    pc.src_width = w;
+    pc.src_height = h;
+    pc.src_bitwidth = _panel_sprite._bitwidth;
+    pc.src_x32_add = 1 << pixelcopy_t::FP_SCALE;
+    pc.src_y32_add = 0;
+
+    auto row0 = reinterpret_cast<argb8888_t*>(rows.get());
+    auto row1 = &row0[w];
+    auto dst = reinterpret_cast<argb8888_t*>(_mipmap.get());
+    uint32_t y = 0;
+    do
+    {
+      for (size_t i = 0; i < 2; ++i)
+      {
+        uint32_t sy = (y + i < h) ? y + i : y;
+        pc.src_x32 = pc.src_xe32 = 0;
+        pc.src_y32 = pc.src_ye32 = sy << pixelcopy_t::FP_SCALE;
+        pc.fp_copy(i ? row1 : row0, 0, w, &pc);
+      }
+      mipmap_reduce(dst, row0, row1, w);
+      dst += (w + 1) >> 1;
+    } while ((y += 2) < h);
+    rows.release();
+
+    // level 2 and later : reduced from the previous level.
+    auto src = reinterpret_cast<argb8888_t*>(_mipmap.get());
+    for (uint_fast8_t level = 1; level < levels; ++level)
+    {
+      w = (w + 1) >> 1;
+      h = (h + 1) >> 1;
+      y = 0;
+      do
+      {
+        mipmap_reduce(dst, &src[y * w], &src[((y + 1 < h) ? y + 1 : y) * w], w);
+        dst += (w + 1) >> 1;
+      } while ((y += 2) < h);
+      src += w * h;
+    }
+
+    _mipmap_levels = levels;
+    _mipmap_transp = transp;
+    _panel_sprite._modified = false;
+    return true;
+  }
+
+  bool LGFX_Sprite::push_mipmap_aa(LovyanGFX* dst, const float* matrix, uint32_t transp)
+  {
+    // squared scale of each source axis.
+    float zx = matrix[0] * matrix[0] + matrix[3] * matrix[3];
+    float zy = matrix[1] * matrix[1] + matrix[4] * matrix[4];
+    float zoom = std::max(zx, zy);
+    uint_fast8_t level = 0;
+    while (zoom < 0.25f && level < MIPMAP_MAX_LEVEL)
+    {
+      zoom *= 4.0f;
+      ++level;
+    }
+    if (!level || !update_mipmap(transp)) return false;
+    if (level > _mipmap_levels) { level = _mipmap_levels; }
+
+    auto data = reinterpret_cast<const argb8888_t*>(_mipmap.get());
+    uint32_t w = (_panel_sprite._panel_width  + 1) >> 1;
+    uint32_t h = (_panel_sprite._panel_height + 1) >> 1;
+    for (uint_fast8_t i = 1; i < level; ++i)
+    {
+      data += w * h;
+      w = (w + 1) >> 1;
+      h = (h + 1) >> 1;
+    }
+
+    // one texel of level n covers 2^n pixels of the sprite.
+    float k = 1 << level;
+    float m[6] = { matrix[0] * k, matrix[1] * k, matrix[2]
+                 , matrix[3] * k, matrix[4] * k, matrix[5] };
+    dst->pushImageAffineWithAA(m, w, h, data);
+    return true;
+  }
+
 //----------------------------------------------------------------------------
  }
 }
@@ -79,6 +79,7 @@ namespace lgfx
     void setWindow(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye) override;
     void drawPixelPreclipped(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor) override;
     void writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t raw_color) override;
+    void drawPixelsPreclipped(const point16_t* points, uint32_t count, const uint32_t* rawcolors, uint32_t rawcolor) override;
     void writeBlock(uint32_t rawcolor, uint32_t len) override;
     void writePixels(pixelcopy_t* param, uint32_t len, bool use_dma) override;
     void writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool) override;
@@ -99,6 +100,7 @@ namespace lgfx
     uint_fast16_t _panel_width;   // rotationしていない状態の幅;
     uint_fast16_t _panel_height;  // rotationしていない状態の高さ;
     uint_fast16_t _bitwidth;
+    bool _modified = true;        // 描画が行われたか否か (mipmapの再生成判定用);
   };
 
   class LGFX_Sprite : public LovyanGFX
@@ -142,8 +144,17 @@ namespace lgfx
 
       _panel_sprite.deleteSprite();
       _img = nullptr;
+      deleteMipmap();
     }
 
+    /// Use a mipmap chain for pushRotateZoomWithAA / pushAffineWithAA when the image is reduced to less than 1/2.
+    /// The chain is built at the first reduced push, and is built again after the sprite has been drawn to.
+    /// ( if the buffer is rewritten directly via getBuffer(), call invalidateMipmap() )
+    void setMipmap(bool enable) { _mipmap_enabled = enable; if (!enable) { deleteMipmap(); } }
+    bool getMipmap(void) const { return _mipmap_enabled; }
+    void invalidateMipmap(void) { _panel_sprite._modified = true; }
+    void deleteMipmap(void) { _mipmap.release(); _mipmap_levels = 0; }
+
     void setPsram( bool enabled )
     {
       if (_psram == enabled) return;
@@ -171,6 +182,7 @@ namespace lgfx
 
     void* createSprite(int32_t w, int32_t h)
     {
+      deleteMipmap();  // 大きさが変わる場合があるため作り直す;
       _img = _panel_sprite.createSprite(w, h, &_write_conv, _psram);
       if (_img) {
         if (!_palette && 0 == _write_conv.bytes)
@@ -285,6 +297,7 @@ namespace lgfx
       for (uint32_t i = 0; i < _palette_count; i++) {
         _palette.img24()[i] = i * k;
       }
+      _panel_sprite._modified = true;
     }
 
     void setBitmapColor(uint16_t fgcolor, uint16_t bgcolor)  // For 1bpp sprites
@@ -292,6 +305,7 @@ namespace lgfx
       if (_palette) {
         _palette.img24()[0].set(color_convert<bgr888_t, rgb565_t>(bgcolor));
         _palette.img24()[1].set(color_convert<bgr888_t, rgb565_t>(fgcolor));
+        _panel_sprite._modified = true;
       }
     }
 
@@ -315,16 +329,17 @@ namespace lgfx
       if (!_palette || index >= _palette_count) return;
       rgb888_t c = convert_to_rgb888(color);
       _palette.img24()[index] = c;
+      _panel_sprite._modified = true;
     }
 
     void setPaletteColor(size_t index, const bgr888_t& rgb)
     {
-      if (_palette && index < _palette_count) { _palette.img24()[index] = rgb; }
+      if (_palette && index < _palette_count) { _palette.img24()[index] = rgb; _panel_sprite._modified = true; }
     }
 
     void setPaletteColor(size_t index, uint8_t r, uint8_t g, uint8_t b)
     {
-      if (_palette && index < _palette_count) { _palette.img24()[index].set(r, g, b); }
+      if (_palette && index < _palette_count) { _palette.img24()[index].set(r, g, b); _panel_sprite._modified = true; }
     }
 
     LGFX_INLINE void* setColorDepth(uint8_t bpp) { return setColorDepth((color_depth_t)bpp); }
@@ -412,8 +427,18 @@ namespace lgfx
     SpriteBuffer _palette;
 //    int32_t _bitwidth;
 
+    SpriteBuffer _mipmap;  // argb8888 levels 1..n (1/2, 1/4, ...)
+    uint32_t _mipmap_transp = pixelcopy_t::NON_TRANSP;
+    uint8_t _mipmap_levels = 0;
+    bool _mipmap_enabled = false;
+
     bool _psram = false;
 
+    static constexpr uint8_t MIPMAP_MAX_LEVEL = 8;
+
+    bool update_mipmap(uint32_t transp);
+    bool push_mipmap_aa(LovyanGFX* dst, const float* matrix, uint32_t transp);
+
     bool create_palette(void)
     {
       if (_write_conv.bits > 8) return false;
@@ -428,6 +453,7 @@ namespace lgfx
       }
       _palette_count = palettes;
       _write_conv.setColorDepth(_write_conv.depth, true);
+      _panel_sprite._modified = true;  // パレットが変わるため mipmap を作り直させる;
       return true;
     }
 
@@ -541,6 +567,12 @@ namespace lgfx
 
     void push_rotate_zoom_aa(LovyanGFX* dst, float x, float y, float angle, float zoom_x, float zoom_y, uint32_t transp = pixelcopy_t::NON_TRANSP)
     {
+      if (_mipmap_enabled)
+      {
+        float matrix[6];
+        make_rotation_matrix(matrix, x + 0.5f, y + 0.5f, _xpivot + 0.5f, _ypivot + 0.5f, angle, zoom_x, zoom_y);
+        if (push_mipmap_aa(dst, matrix, transp)) return;
+      }
       dst->pushImageRotateZoomWithAA(x, y, _xpivot, _ypivot, angle, zoom_x, zoom_y, _panel_sprite._panel_width, _panel_sprite._panel_height, _img, transp, getColorDepth(), _palette.img24());
     }
 
@@ -551,6 +583,7 @@ namespace lgfx
 
     void push_affine_aa(LovyanGFX* dst, const float matrix[6], uint32_t transp = pixelcopy_t::NON_TRANSP)
     {
+      if (_mipmap_enabled && push_mipmap_aa(dst, matrix, transp)) return;
       dst->pushImageAffineWithAA(matrix, _panel_sprite._panel_width, _panel_sprite._panel_height, _img, transp, getColorDepth(), _palette.img24());
     }
 
@@ -0,0 +1,164 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include <type_traits>
+
+#include "LGFXBase.hpp"
+#include "panel/Panel_LCD.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+
+#if defined ( _MSVC_LANG )
+#define LGFX_INLINE                        inline
+#define LGFX_INLINE_T template<typename T> inline
+#else
+#define LGFX_INLINE                        __attribute__ ((always_inline)) inline
+#define LGFX_INLINE_T template<typename T> __attribute__ ((always_inline)) inline
+#endif
+//----------------------------------------------------------------------------
+
+  /// PanelT が Panel_LCD の setWindow と描画処理をそのまま使用しているか;
+  template <class PanelT, bool = std::is_base_of<Panel_LCD, PanelT>::value>
+  struct panel_static_traits
+  {
+    static constexpr bool lcd_window = false;
+  };
+
+  template <class PanelT>
+  struct panel_static_traits<PanelT, true>
+  {
+    static constexpr bool lcd_window = PanelT::static_window
+      && std::is_same<decltype(&PanelT::setWindow)              , decltype(&Panel_LCD::setWindow)              >::value
+      && std::is_same<decltype(&PanelT::drawPixelPreclipped)    , decltype(&Panel_LCD::drawPixelPreclipped)    >::value
+      && std::is_same<decltype(&PanelT::writeFillRectPreclipped), decltype(&Panel_LCD::writeFillRectPreclipped)>::value;
+  };
+
+  /// パネルとバスの型をコンパイル時に確定させた LGFX_Device。;
+  /// drawPixel / writePixel / fillRect / drawFastHLine / drawFastVLine / drawLine を仮想関数を経由せずに描画する。;
+  /// Panel_LCD 系のパネルでは startWrite 中の描画をバスへ直接出力する。それ以外の機能は LGFX_Device と同じ;
+  /// 使い方: static LGFX_Static<Panel_ILI9341, Bus_SPI> lcd;
+  ///         lcd.bus_instance().config(bus_cfg); lcd.panel_instance().config(panel_cfg); lcd.init();
+  /// ※ panel_instance() のバスを別のものに差し替えないこと;
+  template <class PanelT, class BusT>
+  class LGFX_Static : public LGFX_Device
+  {
+    struct panel_t final : public PanelT {};
+    struct bus_t final : public BusT {};
+
+    using lcd_window_t = std::integral_constant<bool, panel_static_traits<PanelT>::lcd_window>;
+    static constexpr bool has_line_engine = !std::is_same<decltype(&PanelT::drawLinePreclipped), decltype(&IPanel::drawLinePreclipped)>::value;
+
+  public:
+    LGFX_Static(void)
+    {
+      _panel_instance.setBus(&_bus_instance);
+      setPanel(&_panel_instance);
+    }
+
+    PanelT& panel_instance(void) { return _panel_instance; }
+    BusT& bus_instance(void) { return _bus_instance; }
+
+    LGFX_INLINE   void drawPixel (int32_t x, int32_t y) { if (x >= _clip_l && x <= _clip_r && y >= _clip_t && y <= _clip_b) { draw_pixel(x, y, getRawColor()); } }
+    LGFX_INLINE_T void drawPixel (int32_t x, int32_t y, const T& color) { setColor(color); drawPixel(x, y); }
+    LGFX_INLINE   void writePixel(int32_t x, int32_t y) { if (x >= _clip_l && x <= _clip_r && y >= _clip_t && y <= _clip_b) { draw_pixel(x, y, getRawColor()); } }
+    LGFX_INLINE_T void writePixel(int32_t x, int32_t y, const T& color) { setColor(color); writePixel(x, y); }
+
+    LGFX_INLINE   void writeFillRectPreclipped(int32_t x, int32_t y, int32_t w, int32_t h) { fill_rect(x, y, w, h, getRawColor()); }
+    LGFX_INLINE_T void writeFillRectPreclipped(int32_t x, int32_t y, int32_t w, int32_t h, const T& color) { setColor(color); writeFillRectPreclipped(x, y, w, h); }
+
+    LGFX_INLINE_T void writeFastVLine(int32_t x, int32_t y, int32_t h, const T& color) { setColor(color); writeFastVLine(x, y, h); }
+    void writeFastVLine(int32_t x, int32_t y, int32_t h)
+    {
+      if (x < _clip_l || x > _clip_r) return;
+      auto ct = _clip_t;
+      if (y < ct) { h += y - ct; y = ct; }
+      auto cb = _clip_b + 1 - y;
+      if (h > cb) h = cb;
+      if (h < 1) return;
+      fill_rect(x, y, 1, h, getRawColor());
+    }
+
+    LGFX_INLINE_T void writeFastHLine(int32_t x, int32_t y, int32_t w, const T& color) { setColor(color); writeFastHLine(x, y, w); }
+    void writeFastHLine(int32_t x, int32_t y, int32_t w)
+    {
+      if (y < _clip_t || y > _clip_b) return;
+      auto cl = _clip_l;
+      if (x < cl) { w += x - cl; x = cl; }
+      auto cr = _clip_r + 1 - x;
+      if (w > cr) w = cr;
+      if (w < 1) return;
+      fill_rect(x, y, w, 1, getRawColor());
+    }
+
+    LGFX_INLINE_T void writeFillRect(int32_t x, int32_t y, int32_t w, int32_t h, const T& color) { setColor(color); writeFillRect(x, y, w, h); }
+    LGFX_INLINE   void writeFillRect(int32_t x, int32_t y, int32_t w, int32_t h) { if (_clipping(x, y, w, h)) { fill_rect(x, y, w, h, getRawColor()); } }
+
+    LGFX_INLINE_T void drawFastVLine(int32_t x, int32_t y, int32_t h, const T& color) { setColor(color); drawFastVLine(x, y, h); }
+    LGFX_INLINE   void drawFastVLine(int32_t x, int32_t y, int32_t h) { _adjust_abs(y, h); startWrite(); writeFastVLine(x, y, h); endWrite(); }
+    LGFX_INLINE_T void drawFastHLine(int32_t x, int32_t y, int32_t w, const T& color) { setColor(color); drawFastHLine(x, y, w); }
+    LGFX_INLINE   void drawFastHLine(int32_t x, int32_t y, int32_t w) { _adjust_abs(x, w); startWrite(); writeFastHLine(x, y, w); endWrite(); }
+    LGFX_INLINE_T void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, const T& color) { setColor(color); fillRect(x, y, w, h); }
+    LGFX_INLINE   void fillRect(int32_t x, int32_t y, int32_t w, int32_t h) { _adjust_abs(x, w); _adjust_abs(y, h); startWrite(); writeFillRect(x, y, w, h); endWrite(); }
+
+    LGFX_INLINE_T void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const T& color) { setColor(color); drawLine(x0, y0, x1, y1); }
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+    {
+      uint32_t rawcolor = getRawColor();
+      auto fill = [this, rawcolor](int32_t x, int32_t y, int32_t w, int32_t h) { fill_rect(x, y, w, h, rawcolor); };
+      if (has_line_engine && _inside_clip(std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1)))
+      {
+        startWrite();
+        if (!_panel_instance.drawLinePreclipped(x0, y0, x1, y1, rawcolor))
+        {
+          _draw_line(x0, y0, x1, y1, fill);
+        }
+        endWrite();
+        return;
+      }
+      _draw_line(x0, y0, x1, y1, fill);
+    }
+
+  protected:
+    bus_t _bus_instance;
+    panel_t _panel_instance;
+
+    LGFX_INLINE void draw_pixel(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor)
+    {
+      if (!draw_pixel_static(lcd_window_t(), x, y, rawcolor)) { _panel_instance.drawPixelPreclipped(x, y, rawcolor); }
+    }
+    LGFX_INLINE bool draw_pixel_static(std::true_type, uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor) { return _panel_instance.drawPixelPreclipped_static(&_bus_instance, x, y, rawcolor); }
+    LGFX_INLINE bool draw_pixel_static(std::false_type, uint_fast16_t, uint_fast16_t, uint32_t) { return false; }
+
+    LGFX_INLINE void fill_rect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
+    {
+      if (!fill_rect_static(lcd_window_t(), x, y, w, h, rawcolor)) { _panel_instance.writeFillRectPreclipped(x, y, w, h, rawcolor); }
+    }
+    LGFX_INLINE bool fill_rect_static(std::true_type, uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor) { return _panel_instance.writeFillRectPreclipped_static(&_bus_instance, x, y, w, h, rawcolor); }
+    LGFX_INLINE bool fill_rect_static(std::false_type, uint_fast16_t, uint_fast16_t, uint_fast16_t, uint_fast16_t, uint32_t) { return false; }
+  };
+
+#undef LGFX_INLINE
+#undef LGFX_INLINE_T
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -29,6 +29,7 @@ Contributors:
 #include "misc/enum.hpp"
 #include "misc/colortype.hpp"
 #include "misc/pixelcopy.hpp"
+#include "misc/range.hpp"
 
 namespace lgfx
 {
@@ -143,6 +144,25 @@ namespace lgfx
     virtual void readRect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param) = 0;
     virtual void copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y) = 0;
 
+    /// 画面全幅の y から h 行の範囲を、ハードウェアのスクロール機能で dy 行 (正で下方向) 動かす。;
+    /// 空いた範囲の描画は呼出し側で行う。対応していない場合は何もせず false を返す;
+    virtual bool scrollVertical(uint_fast16_t y, uint_fast16_t h, int_fast16_t dy) { (void)y; (void)h; (void)dy; return false; }
+
+    /// 描画エンジンを持つパネル向けの図形描画。図形全体が画面内に収まることを呼出し側で保証する。;
+    /// パネル側で描画した場合は true を返す。false の場合は呼出し側で描画する;
+    virtual bool drawLinePreclipped(uint_fast16_t x0, uint_fast16_t y0, uint_fast16_t x1, uint_fast16_t y1, uint32_t rawcolor) { (void)x0; (void)y0; (void)x1; (void)y1; (void)rawcolor; return false; }
+    virtual bool drawEllipsePreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t rx, uint_fast16_t ry, uint32_t rawcolor, bool fill) { (void)x; (void)y; (void)rx; (void)ry; (void)rawcolor; (void)fill; return false; }
+    virtual bool drawTrianglePreclipped(uint_fast16_t x0, uint_fast16_t y0, uint_fast16_t x1, uint_fast16_t y1, uint_fast16_t x2, uint_fast16_t y2, uint32_t rawcolor, bool fill) { (void)x0; (void)y0; (void)x1; (void)y1; (void)x2; (void)y2; (void)rawcolor; (void)fill; return false; }
+    /// r が 0 の場合は矩形;
+    virtual bool drawRoundRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t r, uint32_t rawcolor, bool fill) { (void)x; (void)y; (void)w; (void)h; (void)r; (void)rawcolor; (void)fill; return false; }
+
+    /// 描画範囲内の count 個の点を描画する。rawcolors が nullptr の場合は全ての点を rawcolor で描画する;
+    /// 同じ座標の点が複数ある場合は後の点の色が残る;
+    virtual void drawPixelsPreclipped(const point16_t* points, uint32_t count, const uint32_t* rawcolors, uint32_t rawcolor)
+    {
+      for (uint32_t i = 0; i < count; ++i) { drawPixelPreclipped(points[i].x, points[i].y, rawcolors ? rawcolors[i] : rawcolor); }
+    }
+
     virtual void writeFillRectAlphaPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t argb8888)
     {
       effect(x, y, w, h, effect_fill_alpha ( argb8888_t { argb8888 } ) );
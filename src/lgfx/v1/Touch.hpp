@@ -34,6 +34,13 @@ namespace lgfx
     uint16_t id   = 0;
   };
 
+  struct touch_event_t
+  {
+    touch_point_t point;  /// キャリブレーション済みの座標 (getTouchと同じ);
+    uint32_t msec = 0;    /// 取得した時刻 (millis);
+    uint8_t count = 0;    /// 同時に取得した点の数。0の場合は全て離されたことを示す;
+  };
+
 //----------------------------------------------------------------------------
 
   struct ITouch
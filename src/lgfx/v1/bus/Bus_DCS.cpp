@@ -0,0 +1,483 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#include "Bus_DCS.hpp"
+
+#include "../misc/pixelcopy.hpp"
+
+#include <string.h>
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  static constexpr uint8_t CMD_SWRESET = 0x01;
+  static constexpr uint8_t CMD_RDDID   = 0x04;
+  static constexpr uint8_t CMD_RDDPM   = 0x0A;
+  static constexpr uint8_t CMD_RDDMADCTL = 0x0B;
+  static constexpr uint8_t CMD_RDDCOLMOD = 0x0C;
+  static constexpr uint8_t CMD_SLPIN   = 0x10;
+  static constexpr uint8_t CMD_SLPOUT  = 0x11;
+  static constexpr uint8_t CMD_INVOFF  = 0x20;
+  static constexpr uint8_t CMD_INVON   = 0x21;
+  static constexpr uint8_t CMD_DISPOFF = 0x28;
+  static constexpr uint8_t CMD_DISPON  = 0x29;
+  static constexpr uint8_t CMD_CASET   = 0x2A;
+  static constexpr uint8_t CMD_RASET   = 0x2B;
+  static constexpr uint8_t CMD_RAMWR   = 0x2C;
+  static constexpr uint8_t CMD_RAMRD   = 0x2E;
+  static constexpr uint8_t CMD_VSCRDEF = 0x33;
+  static constexpr uint8_t CMD_MADCTL  = 0x36;
+  static constexpr uint8_t CMD_VSCRSADD= 0x37;
+  static constexpr uint8_t CMD_COLMOD  = 0x3A;
+  static constexpr uint8_t CMD_RAMWRC  = 0x3C;
+  static constexpr uint8_t CMD_RAMRDC  = 0x3E;
+
+  static constexpr uint8_t MAD_MY = 0x80;
+  static constexpr uint8_t MAD_MX = 0x40;
+  static constexpr uint8_t MAD_MV = 0x20;
+
+  Bus_DCS::Bus_DCS(void)
+  {
+    memset(_cmd_count, 0, sizeof(_cmd_count));
+    memset(_param_len, 0, sizeof(_param_len));
+    reset();
+  }
+
+  void Bus_DCS::config(const config_t& cfg)
+  {
+    if (_gram && (_cfg.memory_width != cfg.memory_width || _cfg.memory_height != cfg.memory_height))
+    {
+      release();
+    }
+    _cfg = cfg;
+  }
+
+  bool Bus_DCS::init(void)
+  {
+    if (_gram == nullptr)
+    {
+      size_t len = _cfg.memory_width * _cfg.memory_height * 3;
+      _gram = (uint8_t*)heap_alloc_psram(len);
+      if (_gram == nullptr) { _gram = (uint8_t*)heap_alloc(len); }
+      if (_gram == nullptr) { return false; }
+      memset(_gram, 0, len);
+    }
+    memset(_cmd_count, 0, sizeof(_cmd_count));
+    memset(_param_len, 0, sizeof(_param_len));
+    reset();
+    resetWireTime();
+    return true;
+  }
+
+  void Bus_DCS::release(void)
+  {
+    if (_gram)
+    {
+      heap_free(_gram);
+      _gram = nullptr;
+    }
+    _flip_buffer.deleteBuffer();
+  }
+
+  void Bus_DCS::reset(void)
+  {
+    _madctl = 0;
+    _colmod = 0x66;
+    _invert = false;
+    _sleep = true;
+    _display_on = false;
+    _xs = _ys = _x = _y = 0;
+    _xe = _cfg.memory_width - 1;
+    _ye = _cfg.memory_height - 1;
+    _cmd = 0;
+    _param_idx = 0;
+    _pixel_len = 0;
+    _vs_top = 0;
+    _vs_height = _cfg.memory_height;
+    _vs_start = 0;
+  }
+
+  void Bus_DCS::resetWireTime(void)
+  {
+    _write_cycles = 0;
+    _read_cycles = 0;
+    _write_bytes = 0;
+    _read_bytes = 0;
+  }
+
+  uint32_t Bus_DCS::getWireUsec(void) const
+  {
+    uint64_t res = 0;
+    if (_cfg.freq_write) { res += _write_cycles * 1000000 / _cfg.freq_write; }
+    if (_cfg.freq_read ) { res += _read_cycles  * 1000000 / _cfg.freq_read;  }
+    return res;
+  }
+
+  void Bus_DCS::add_write(uint32_t bits, uint32_t count)
+  {
+    uint32_t bw = _cfg.bus_width ? _cfg.bus_width : 1;
+    _write_cycles += (uint64_t)((bits + bw - 1) / bw) * count;
+    _write_bytes += (uint64_t)(bits >> 3) * count;
+  }
+
+  void Bus_DCS::add_read(uint32_t bits)
+  {
+    uint32_t bw = _cfg.bus_width ? _cfg.bus_width : 1;
+    _read_cycles += (bits + bw - 1) / bw;
+    _read_bytes += bits >> 3;
+  }
+
+  uint32_t Bus_DCS::readGRAM(uint_fast16_t x, uint_fast16_t y) const
+  {
+    if (_gram == nullptr || x >= _cfg.memory_width || y >= _cfg.memory_height) { return 0; }
+    auto p = &_gram[(x + y * _cfg.memory_width) * 3];
+    return p[0] << 16 | p[1] << 8 | p[2];
+  }
+
+  uint32_t Bus_DCS::readDisplay(uint_fast16_t x, uint_fast16_t y) const
+  {
+    // 垂直スクロール範囲内の行は VSCRSADD で指定された行から順に表示される;
+    if (y >= _vs_top && y - _vs_top < _vs_height)
+    {
+      int32_t row = (int32_t)(y - _vs_top) + _vs_start - _vs_top;
+      row %= _vs_height;
+      if (row < 0) { row += _vs_height; }
+      y = _vs_top + row;
+    }
+    return readGRAM(x, y);
+  }
+
+  uint8_t* Bus_DCS::gram_ptr(void) const
+  {
+    uint_fast16_t x = _x;
+    uint_fast16_t y = _y;
+    // MV : 行と列の入替え、 MX/MY : 左右・上下の反転;
+    if (_madctl & MAD_MV) { std::swap(x, y); }
+    if (_gram == nullptr || x >= _cfg.memory_width || y >= _cfg.memory_height) { return nullptr; }
+    if (_madctl & MAD_MX) { x = _cfg.memory_width  - 1 - x; }
+    if (_madctl & MAD_MY) { y = _cfg.memory_height - 1 - y; }
+    return &_gram[(x + y * _cfg.memory_width) * 3];
+  }
+
+  void Bus_DCS::next_pos(void)
+  {
+    if (++_x > _xe)
+    {
+      _x = _xs;
+      if (++_y > _ye) { _y = _ys; }
+    }
+  }
+
+  bool Bus_DCS::writeCommand(uint32_t data, uint_fast8_t bit_length)
+  {
+    add_write(bit_length);
+    // 16bit長の場合は後に送られる下位側がコマンドとなる;
+    uint8_t cmd = data >> (bit_length - 8);
+    ++_cmd_count[cmd];
+    _param_len[cmd] = 0;
+    _param_idx = 0;
+    _pixel_len = 0;
+    _cmd = cmd;
+    switch (cmd)
+    {
+    case CMD_SWRESET: reset(); _cmd = cmd; break;
+    case CMD_SLPIN:   _sleep = true;       break;
+    case CMD_SLPOUT:  _sleep = false;      break;
+    case CMD_INVOFF:  _invert = false;     break;
+    case CMD_INVON:   _invert = true;      break;
+    case CMD_DISPOFF: _display_on = false; break;
+    case CMD_DISPON:  _display_on = true;  break;
+    case CMD_RAMWR:
+    case CMD_RAMRD:
+      _x = _xs;
+      _y = _ys;
+      break;
+    default: break;
+    }
+    return true;
+  }
+
+  void Bus_DCS::put_param(uint8_t data)
+  {
+    uint32_t idx = _param_idx++;
+    if (_cfg.dlen_16bit)
+    { // 16bit単位の場合は下位側のみ有効;
+      if (!(idx & 1)) { return; }
+      idx >>= 1;
+    }
+    if (idx < params_max)
+    {
+      _params[_cmd][idx] = data;
+      _param_len[_cmd] = idx + 1;
+    }
+    switch (_cmd)
+    {
+    case CMD_CASET:
+    case CMD_RASET:
+      if (idx == 3)
+      {
+        auto p = _params[_cmd];
+        uint16_t s = p[0] << 8 | p[1];
+        uint16_t e = p[2] << 8 | p[3];
+        if (_cmd == CMD_CASET) { _xs = s; _xe = e; }
+        else                   { _ys = s; _ye = e; }
+      }
+      break;
+
+    case CMD_VSCRDEF:
+      if (idx == 5)
+      {
+        auto p = _params[_cmd];
+        uint16_t tfa = p[0] << 8 | p[1];
+        uint16_t vsa = p[2] << 8 | p[3];
+        if (vsa && tfa + vsa <= _cfg.memory_height)
+        {
+          _vs_top = tfa;
+          _vs_height = vsa;
+        }
+      }
+      break;
+
+    case CMD_VSCRSADD:
+      if (idx == 1)
+      {
+        auto p = _params[_cmd];
+        _vs_start = p[0] << 8 | p[1];
+      }
+      break;
+
+    case CMD_MADCTL: if (idx == 0) { _madctl = data; } break;
+    case CMD_COLMOD: if (idx == 0) { _colmod = data; } break;
+    default: break;
+    }
+  }
+
+  void Bus_DCS::put_pixel(uint8_t data)
+  {
+    _pixel[_pixel_len++] = data;
+    uint8_t r, g, b;
+    if ((_colmod & 7) == 5)
+    { // RGB565 を 18bit に拡張する (R/B は最上位ビットを最下位に複製);
+      if (_pixel_len < 2) { return; }
+      uint_fast8_t r5 = _pixel[0] >> 3;
+      uint_fast8_t b5 = _pixel[1] & 0x1F;
+      r = (r5 << 3) | ((r5 >> 4) << 2);
+      g = ((_pixel[0] << 5) | ((_pixel[1] >> 3) & 0x1C)) & 0xFC;
+      b = (b5 << 3) | ((b5 >> 4) << 2);
+    }
+    else
+    {
+      if (_pixel_len < 3) { return; }
+      r = _pixel[0] & 0xFC;
+      g = _pixel[1] & 0xFC;
+      b = _pixel[2] & 0xFC;
+    }
+    _pixel_len = 0;
+    if (auto p = gram_ptr())
+    {
+      p[0] = r;
+      p[1] = g;
+      p[2] = b;
+    }
+    next_pos();
+  }
+
+  void Bus_DCS::put_byte(uint8_t data)
+  {
+    if (_cmd == CMD_RAMWR || _cmd == CMD_RAMWRC) { put_pixel(data); }
+    else { put_param(data); }
+  }
+
+  void Bus_DCS::writeData(uint32_t data, uint_fast8_t bit_length)
+  {
+    add_write(bit_length);
+    for (uint_fast8_t i = 0; i < bit_length; i += 8)
+    {
+      put_byte(data >> i);
+    }
+  }
+
+  void Bus_DCS::writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count)
+  {
+    add_write(bit_length, count);
+    while (count--)
+    {
+      for (uint_fast8_t i = 0; i < bit_length; i += 8)
+      {
+        put_byte(data >> i);
+      }
+    }
+  }
+
+  void Bus_DCS::writePixels(pixelcopy_t* pc, uint32_t length)
+  {
+    uint8_t buf[192];
+    uint32_t bytes = pc->dst_bits >> 3;
+    uint32_t chunk = sizeof(buf) / bytes;
+    while (length)
+    {
+      uint32_t len = length < chunk ? length : chunk;
+      pc->fp_copy(buf, 0, len, pc);
+      writeBytes(buf, len * bytes, true, false);
+      length -= len;
+    }
+  }
+
+  void Bus_DCS::writeBytes(const uint8_t* data, uint32_t length, bool dc, bool use_dma)
+  {
+    if (!dc)
+    {
+      for (uint32_t i = 0; i < length; ++i) { writeCommand(data[i], 8); }
+      return;
+    }
+    add_write(length << 3);
+    for (uint32_t i = 0; i < length; ++i) { put_byte(data[i]); }
+  }
+
+//----------------------------------------------------------------------------
+
+  uint8_t Bus_DCS::next_response(void)
+  {
+    if (_cmd == CMD_RAMRD || _cmd == CMD_RAMRDC)
+    {
+      bool rgb565 = _cfg.read_colmod && (_colmod & 7) == 5;
+      if (_read_pos >= (rgb565 ? 2 : 3))
+      {
+        _read_pos = 0;
+        uint8_t rgb[3] = { 0, 0, 0 };
+        if (auto p = gram_ptr()) { memcpy(rgb, p, 3); }
+        next_pos();
+        if (rgb565)
+        {
+          _read_pixel[0] = (rgb[0] & 0xF8) | rgb[1] >> 5;
+          _read_pixel[1] = (rgb[1] & 0x1C) << 3 | rgb[2] >> 3;
+        }
+        else
+        {
+          memcpy(_read_pixel, rgb, 3);
+        }
+      }
+      return _read_pixel[_read_pos++];
+    }
+
+    uint32_t idx = _read_idx++;
+    switch (_cmd)
+    {
+    case CMD_RDDID:      return idx < 3 ? _cfg.id >> (16 - idx * 8) : 0;
+    case CMD_RDDPM:      return idx ? 0 : (0x80 | (_sleep ? 0 : 0x10) | (_display_on ? 0x04 : 0));
+    case CMD_RDDMADCTL:  return idx ? 0 : _madctl;
+    case CMD_RDDCOLMOD:  return idx ? 0 : _colmod;
+    default:             return 0;
+    }
+  }
+
+  uint8_t Bus_DCS::read_byte(void)
+  {
+    if (_dummy_left == 0 && _read_avail == 0) { return next_response(); }
+
+    // ダミービットによりバイト境界がずれている場合;
+    uint_fast8_t res = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+      uint_fast8_t bit = 0;
+      if (_dummy_left) { --_dummy_left; }
+      else
+      {
+        if (_read_avail == 0)
+        {
+          _read_shift = next_response();
+          _read_avail = 8;
+        }
+        bit = (_read_shift >> --_read_avail) & 1;
+      }
+      res = res << 1 | bit;
+    }
+    return res;
+  }
+
+  void Bus_DCS::beginRead(uint_fast8_t dummy_bits)
+  {
+    bool ram = (_cmd == CMD_RAMRD || _cmd == CMD_RAMRDC);
+    _dummy_left = ram ? _cfg.dummy_read_pixel : _cfg.dummy_read_bits;
+    _read_avail = 0;
+    _read_idx = 0;
+    _read_pos = 3;
+    add_read(dummy_bits);
+
+    // 呼出し側が指定したビット数を読み捨てる;
+    for (; dummy_bits >= 8; dummy_bits -= 8) { read_byte(); }
+    while (dummy_bits--)
+    {
+      if (_dummy_left) { --_dummy_left; continue; }
+      if (_read_avail == 0)
+      {
+        _read_shift = next_response();
+        _read_avail = 8;
+      }
+      --_read_avail;
+    }
+  }
+
+  void Bus_DCS::endRead(void)
+  {
+    _dummy_left = 0;
+    _read_avail = 0;
+  }
+
+  uint32_t Bus_DCS::readData(uint_fast8_t bit_length)
+  {
+    add_read(bit_length);
+    uint32_t res = 0;
+    for (uint_fast8_t i = 0; i < bit_length; i += 8)
+    {
+      res |= read_byte() << i;
+    }
+    return res;
+  }
+
+  bool Bus_DCS::readBytes(uint8_t* dst, uint32_t length, bool use_dma)
+  {
+    add_read(length << 3);
+    for (uint32_t i = 0; i < length; ++i) { dst[i] = read_byte(); }
+    return true;
+  }
+
+  void Bus_DCS::readPixels(void* dst, pixelcopy_t* param, uint32_t length)
+  {
+    uint8_t buf[96];
+    uint32_t bytes = param->src_bits >> 3;
+    uint32_t chunk = sizeof(buf) / bytes;
+    auto src_data = param->src_data;
+    param->src_data = buf;
+    int32_t dstindex = 0;
+    while (length)
+    {
+      uint32_t len = length < chunk ? length : chunk;
+      readBytes(buf, len * bytes, false);
+      param->src_x = 0;
+      dstindex = param->fp_copy(dst, dstindex, dstindex + len, param);
+      length -= len;
+    }
+    param->src_data = src_data;
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
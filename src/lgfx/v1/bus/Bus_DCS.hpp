@@ -0,0 +1,174 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "../Bus.hpp"
+#include "../platforms/common.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// MIPI-DCS 系のLCDコントローラ (ILI9341, ST7789, ST7796, GC9A01 等) を模倣するバス。;
+  /// CASET / RASET / RAMWR / RAMRD / MADCTL / COLMOD 等を解釈してメモリ上のGRAMに反映し、;
+  /// 設定したクロックとバス幅から通信時間を見積もる。実機なしで Panel_LCD 系の動作確認を行う場合に用いる;
+  /// 使い方: _dcs.config(cfg); _panel_instance.setBus(&_dcs);
+  class Bus_DCS : public IBus
+  {
+  public:
+    struct config_t
+    {
+      /// GRAMの大きさ (Panel の memory_width / memory_height に合わせる);
+      uint16_t memory_width = 240;
+      uint16_t memory_height = 320;
+
+      uint32_t freq_write = 40000000;
+      uint32_t freq_read  = 16000000;
+
+      /// 1:SPI 8:8bitパラレル 16:16bitパラレル;
+      uint8_t bus_width = 1;
+
+      /// コマンドのパラメータを16bit単位で受け取る (Panel の dlen_16bit に合わせる);
+      bool dlen_16bit = false;
+
+      /// RAMRD の読出し形式を COLMOD に従わせる (ST7796 等)。false の場合は常に 18bit (3Byte) で読み出す;
+      bool read_colmod = false;
+
+      /// RAMRD の応答の前に出力するダミーのビット数 (Panel の dummy_read_pixel に相当);
+      uint8_t dummy_read_pixel = 8;
+
+      /// レジスタ読出しの応答の前に出力するダミーのビット数 (Panel の dummy_read_bits に相当);
+      uint8_t dummy_read_bits = 1;
+
+      /// RDDID (04h) で返す値 (下位24bit、上位から順に出力する);
+      uint32_t id = 0;
+    };
+
+    Bus_DCS(void);
+    virtual ~Bus_DCS(void) { release(); }
+
+    const config_t& config(void) const { return _cfg; }
+    void config(const config_t& cfg);
+
+    bus_type_t busType(void) const override { return _cfg.bus_width == 1 ? bus_spi : (_cfg.bus_width == 8 ? bus_parallel8 : bus_parallel16); }
+    bool init(void) override;
+    void release(void) override;
+    uint32_t getClock(void) const override { return _cfg.freq_write; }
+    void setClock(uint32_t freq) override { _cfg.freq_write = freq; }
+
+    void beginTransaction(void) override {}
+    void endTransaction(void) override {}
+    void wait(void) override {}
+    bool busy(void) const override { return false; }
+
+    void initDMA(void) override {}
+    void addDMAQueue(const uint8_t* data, uint32_t length) override { writeBytes(data, length, true, true); }
+    void execDMAQueue(void) override {}
+    uint8_t* getDMABuffer(uint32_t length) override { return _flip_buffer.getBuffer(length); }
+
+    void flush(void) override {}
+    bool writeCommand(uint32_t data, uint_fast8_t bit_length) override;
+    void writeData(uint32_t data, uint_fast8_t bit_length) override;
+    void writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count) override;
+    void writePixels(pixelcopy_t* pc, uint32_t length) override;
+    void writeBytes(const uint8_t* data, uint32_t length, bool dc, bool use_dma) override;
+
+    void beginRead(uint_fast8_t dummy_bits) override;
+    void beginRead(void) override { beginRead(0); }
+    void endRead(void) override;
+    uint32_t readData(uint_fast8_t bit_length) override;
+    bool readBytes(uint8_t* dst, uint32_t length, bool use_dma) override;
+    void readPixels(void* dst, pixelcopy_t* pc, uint32_t length) override;
+
+    /// ハードウェアリセット相当 (GRAMの内容は保持する);
+    void reset(void);
+
+    /// GRAMの内容 (1画素3Byte R,G,B の順。各色上位6bitが有効);
+    const uint8_t* getGRAM(void) const { return _gram; }
+    uint32_t readGRAM(uint_fast16_t x, uint_fast16_t y) const;
+    /// 表示される内容 (垂直スクロール (VSCRDEF / VSCRSADD) を反映した、パネルの走査順の x,y の画素);
+    uint32_t readDisplay(uint_fast16_t x, uint_fast16_t y) const;
+
+    uint8_t getMadCtl(void) const { return _madctl; }
+    uint8_t getColMod(void) const { return _colmod; }
+    bool getInvert(void) const { return _invert; }
+    bool getSleep(void) const { return _sleep; }
+    bool getDisplayOn(void) const { return _display_on; }
+
+    /// コマンド毎の受信回数と、最後に受け取ったパラメータ (先頭16Byteまで);
+    uint32_t getCommandCount(uint8_t cmd) const { return _cmd_count[cmd]; }
+    const uint8_t* getParams(uint8_t cmd, uint_fast8_t* length) const { if (length) { *length = _param_len[cmd]; } return _params[cmd]; }
+
+    /// 通信時間の見積り (reset / resetWireTime からの累計);
+    uint32_t getWireUsec(void) const;
+    uint64_t getWriteBytes(void) const { return _write_bytes; }
+    uint64_t getReadBytes(void) const { return _read_bytes; }
+    void resetWireTime(void);
+
+  protected:
+    static constexpr uint8_t params_max = 16;
+
+    config_t _cfg;
+    FlipBuffer _flip_buffer;
+    uint8_t* _gram = nullptr;
+    uint64_t _write_cycles = 0;
+    uint64_t _read_cycles = 0;
+    uint64_t _write_bytes = 0;
+    uint64_t _read_bytes = 0;
+
+    uint32_t _cmd_count[256];
+    uint8_t _params[256][params_max];
+    uint8_t _param_len[256];
+
+    uint16_t _xs, _xe, _ys, _ye;  // CASET / RASET の範囲;
+    uint16_t _x, _y;              // RAMWR / RAMRD の現在位置;
+    uint32_t _param_idx = 0;
+    uint8_t _cmd = 0;
+    uint8_t _madctl;
+    uint8_t _colmod;
+    uint8_t _pixel[3];
+    uint8_t _pixel_len = 0;
+    uint16_t _vs_top;     // 垂直スクロール範囲の先頭行;
+    uint16_t _vs_height;  // 垂直スクロール範囲の行数;
+    uint16_t _vs_start;   // スクロール範囲の先頭に表示するGRAMの行;
+    uint8_t _read_pixel[3];
+    uint8_t _read_pos = 0;
+    uint8_t _read_shift = 0;  // 応答の読出し中のバイト;
+    uint8_t _read_avail = 0;  // _read_shift の残りビット数;
+    uint16_t _dummy_left = 0;
+    uint32_t _read_idx = 0;
+    bool _invert;
+    bool _sleep;
+    bool _display_on;
+
+    void add_write(uint32_t bits, uint32_t count = 1);
+    void add_read(uint32_t bits);
+    void put_byte(uint8_t data);
+    void put_param(uint8_t data);
+    void put_pixel(uint8_t data);
+    uint8_t next_response(void);
+    uint8_t read_byte(void);
+    uint8_t* gram_ptr(void) const;
+    void next_pos(void);
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -0,0 +1,828 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#include "Bus_RA8875.hpp"
+#include "../misc/pixelcopy.hpp"
+
+#include <string.h>
+#include <stdlib.h>
+#include <algorithm>
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  static constexpr uint8_t REG_MRWC = 0x02;
+
+  Bus_RA8875::Bus_RA8875(void)
+  {
+    reset();
+  }
+
+  void Bus_RA8875::config(const config_t& cfg)
+  {
+    if (_gram && (_cfg.memory_width != cfg.memory_width || _cfg.memory_height != cfg.memory_height))
+    {
+      release();
+    }
+    _cfg = cfg;
+  }
+
+  bool Bus_RA8875::init(void)
+  {
+    if (_gram == nullptr)
+    {
+      size_t len = _cfg.memory_width * _cfg.memory_height * sizeof(uint16_t);
+      _gram = (uint16_t*)heap_alloc_psram(len);
+      if (_gram == nullptr) { _gram = (uint16_t*)heap_alloc(len); }
+      if (_gram == nullptr) { return false; }
+      memset(_gram, 0, len);
+    }
+    reset();
+    resetWireTime();
+    return true;
+  }
+
+  void Bus_RA8875::release(void)
+  {
+    if (_gram)
+    {
+      heap_free(_gram);
+      _gram = nullptr;
+    }
+    _flip_buffer.deleteBuffer();
+  }
+
+  void Bus_RA8875::reset(void)
+  {
+    memset(_reg, 0, sizeof(_reg));
+    // アクティブウィンドウの初期値はGRAM全体とする;
+    _reg[0x34] = _cfg.memory_width - 1;
+    _reg[0x35] = (_cfg.memory_width - 1) >> 8;
+    _reg[0x36] = _cfg.memory_height - 1;
+    _reg[0x37] = (_cfg.memory_height - 1) >> 8;
+    _cur = 0;
+    _spi_has_op = false;
+    _spi_stream = false;
+    _wx = _wy = _rx = _ry = 0;
+    _pixel_len = 0;
+    _reg_writes = 0;
+    _engine_count = 0;
+  }
+
+  void Bus_RA8875::resetWireTime(void)
+  {
+    _write_cycles = 0;
+    _read_cycles = 0;
+    _write_bytes = 0;
+    _read_bytes = 0;
+  }
+
+  uint32_t Bus_RA8875::getWireUsec(void) const
+  {
+    uint64_t res = 0;
+    if (_cfg.freq_write) { res += _write_cycles * 1000000 / _cfg.freq_write; }
+    if (_cfg.freq_read ) { res += _read_cycles  * 1000000 / _cfg.freq_read;  }
+    return res;
+  }
+
+  void Bus_RA8875::add_write(uint32_t bits, uint32_t count)
+  {
+    uint32_t bw = _cfg.bus_width ? _cfg.bus_width : 1;
+    _write_cycles += (uint64_t)((bits + bw - 1) / bw) * count;
+    _write_bytes += (uint64_t)(bits >> 3) * count;
+  }
+
+  void Bus_RA8875::add_read(uint32_t bits)
+  {
+    uint32_t bw = _cfg.bus_width ? _cfg.bus_width : 1;
+    _read_cycles += (bits + bw - 1) / bw;
+    _read_bytes += bits >> 3;
+  }
+
+  uint32_t Bus_RA8875::readGRAM(uint_fast16_t x, uint_fast16_t y) const
+  {
+    if (_gram == nullptr || x >= _cfg.memory_width || y >= _cfg.memory_height) { return 0; }
+    uint_fast16_t c = _gram[x + y * _cfg.memory_width];
+    return (c >> 11) << 19 | ((c >> 5) & 0x3F) << 10 | (c & 0x1F) << 3;
+  }
+
+  uint16_t Bus_RA8875::fgcolor(void) const
+  {
+    if (is_16bpp())
+    {
+      return (_reg[0x63] & 0x1F) << 11 | (_reg[0x64] & 0x3F) << 5 | (_reg[0x65] & 0x1F);
+    }
+    // 256色モード : RGB332 を RGB565 に拡張する;
+    uint_fast8_t r = _reg[0x63] & 7;
+    uint_fast8_t g = _reg[0x64] & 7;
+    uint_fast8_t b = _reg[0x65] & 3;
+    return (r << 2 | r >> 1) << 11 | (g << 3 | g) << 5 | (b << 3 | b << 1 | b >> 1);
+  }
+
+//----------------------------------------------------------------------------
+
+  void Bus_RA8875::next_pos(uint16_t& x, uint16_t& y, uint_fast8_t dir) const
+  {
+    uint_fast16_t xs = reg16(0x30);
+    uint_fast16_t ys = reg16(0x32);
+    uint_fast16_t xe = reg16(0x34);
+    uint_fast16_t ye = reg16(0x36);
+    switch (dir & 3)
+    {
+    default:
+    case 0:
+      if (++x > xe) { x = xs; if (++y > ye) { y = ys; } }
+      break;
+    case 1:
+      if (x <= xs) { x = xe; if (++y > ye) { y = ys; } } else { --x; }
+      break;
+    case 2:
+      if (++y > ye) { y = ys; if (++x > xe) { x = xs; } }
+      break;
+    case 3:
+      if (y <= ys) { y = ye; if (++x > xe) { x = xs; } } else { --y; }
+      break;
+    }
+  }
+
+  void Bus_RA8875::plot(int32_t x, int32_t y, uint16_t color)
+  {
+    if (x < (int32_t)reg16(0x30) || x > (int32_t)reg16(0x34)
+     || y < (int32_t)reg16(0x32) || y > (int32_t)reg16(0x36)
+     || x >= _cfg.memory_width || y >= _cfg.memory_height || x < 0 || y < 0) { return; }
+    _gram[x + y * _cfg.memory_width] = color;
+  }
+
+  void Bus_RA8875::fill_rect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color)
+  {
+    int32_t xs = std::max<int32_t>(x, reg16(0x30));
+    int32_t ys = std::max<int32_t>(y, reg16(0x32));
+    int32_t xe = std::min<int32_t>(x + w - 1, std::min<int32_t>(reg16(0x34), _cfg.memory_width  - 1));
+    int32_t ye = std::min<int32_t>(y + h - 1, std::min<int32_t>(reg16(0x36), _cfg.memory_height - 1));
+    for (y = ys; y <= ye; ++y)
+    {
+      for (x = xs; x <= xe; ++x)
+      {
+        _gram[x + y * _cfg.memory_width] = color;
+      }
+    }
+  }
+
+  void Bus_RA8875::put_pixel(uint8_t data)
+  {
+    uint16_t color;
+    if (is_16bpp())
+    { // 上位バイトから受け取る;
+      if (_pixel_len == 0)
+      {
+        _pixel_hi = data;
+        _pixel_len = 1;
+        return;
+      }
+      _pixel_len = 0;
+      color = _pixel_hi << 8 | data;
+    }
+    else
+    {
+      uint_fast8_t r = data >> 5;
+      uint_fast8_t g = (data >> 2) & 7;
+      uint_fast8_t b = data & 3;
+      color = (r << 2 | r >> 1) << 11 | (g << 3 | g) << 5 | (b << 3 | b << 1 | b >> 1);
+    }
+    if (_wx < _cfg.memory_width && _wy < _cfg.memory_height)
+    {
+      _gram[_wx + _wy * _cfg.memory_width] = color;
+    }
+    next_pos(_wx, _wy, _reg[0x40] >> 2);
+  }
+
+  void Bus_RA8875::write_reg(uint8_t reg, uint8_t data)
+  {
+    ++_reg_writes;
+    _reg[reg] = data;
+    switch (reg)
+    {
+    case 0x46: case 0x47: _wx = reg16(0x46); _pixel_len = 0; break;
+    case 0x48: case 0x49: _wy = reg16(0x48); _pixel_len = 0; break;
+    case 0x4A: case 0x4B: _rx = reg16(0x4A); break;
+    case 0x4C: case 0x4D: _ry = reg16(0x4C); break;
+    case 0x50: if (data & 0x80) { exec_bte(); } break;
+    case 0x90: if (data & 0xC0) { exec_draw(); } break;
+    case 0xA0: if (data & 0x80) { exec_ellipse(); } break;
+    default: break;
+    }
+  }
+
+  void Bus_RA8875::put_byte(uint8_t data)
+  {
+    if (_cur == REG_MRWC) { put_pixel(data); }
+    else { write_reg(_cur, data); }
+  }
+
+  void Bus_RA8875::put_spi(uint8_t data)
+  {
+    // SPI : 先頭バイト (0x80:コマンド 0x00:データ書込 0x40:データ読出 0xC0:状態読出) と値の組で受け取る;
+    if (!_spi_has_op)
+    {
+      _spi_op = data;
+      _spi_has_op = true;
+      return;
+    }
+    _spi_has_op = false;
+    switch (_spi_op)
+    {
+    case 0x80: _cur = data; _pixel_len = 0; break;
+    case 0x00: put_byte(data); break;
+    default: break;
+    }
+  }
+
+  bool Bus_RA8875::writeCommand(uint32_t data, uint_fast8_t bit_length)
+  {
+    add_write(bit_length);
+    if (_cfg.bus_width == 1)
+    { // コマンド送信はCSの区切りと同じく扱う。データ書込の先頭バイトで終わった場合は以降の送信をデータとする;
+      _spi_has_op = false;
+      _spi_stream = false;
+      for (uint_fast8_t i = 0; i < bit_length; i += 8)
+      {
+        put_spi(data >> i);
+      }
+      if (_spi_has_op && _spi_op == 0x00)
+      {
+        _spi_has_op = false;
+        _spi_stream = true;
+      }
+      return true;
+    }
+    // 16bit長の場合は後に送られる下位側がレジスタ番号となる;
+    _cur = data >> (bit_length - 8);
+    _pixel_len = 0;
+    return true;
+  }
+
+  void Bus_RA8875::writeData(uint32_t data, uint_fast8_t bit_length)
+  {
+    add_write(bit_length);
+    for (uint_fast8_t i = 0; i < bit_length; i += 8)
+    {
+      uint8_t d = data >> i;
+      if (_cfg.bus_width == 1 && !_spi_stream) { put_spi(d); continue; }
+      // 16bit単位のレジスタ書込みは下位側のみ有効;
+      if (_cfg.dlen_16bit && _cur != REG_MRWC && !(i & 8)) { continue; }
+      put_byte(d);
+    }
+  }
+
+  void Bus_RA8875::writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count)
+  {
+    while (count--)
+    {
+      writeData(data, bit_length);
+    }
+  }
+
+  void Bus_RA8875::writePixels(pixelcopy_t* pc, uint32_t length)
+  {
+    uint8_t buf[192];
+    uint32_t bytes = pc->dst_bits >> 3;
+    uint32_t chunk = sizeof(buf) / bytes;
+    while (length)
+    {
+      uint32_t len = length < chunk ? length : chunk;
+      pc->fp_copy(buf, 0, len, pc);
+      writeBytes(buf, len * bytes, true, false);
+      length -= len;
+    }
+  }
+
+  void Bus_RA8875::writeBytes(const uint8_t* data, uint32_t length, bool dc, bool use_dma)
+  {
+    if (!dc)
+    {
+      for (uint32_t i = 0; i < length; ++i) { writeCommand(data[i], 8); }
+      return;
+    }
+    for (uint32_t i = 0; i < length; ++i) { writeData(data[i], 8); }
+  }
+
+//----------------------------------------------------------------------------
+
+  uint8_t Bus_RA8875::read_byte(void)
+  {
+    if (_dummy_left) { --_dummy_left; return 0; }
+    if (_cur != REG_MRWC) { return _reg[_cur]; }
+    if (_read_pos >= _read_len)
+    {
+      uint16_t c = (_rx < _cfg.memory_width && _ry < _cfg.memory_height) ? _gram[_rx + _ry * _cfg.memory_width] : 0;
+      next_pos(_rx, _ry, _reg[0x45]);
+      _read_pos = 0;
+      if (is_16bpp())
+      {
+        _read_pixel[0] = c >> 8;
+        _read_pixel[1] = c;
+        _read_len = 2;
+      }
+      else
+      {
+        _read_pixel[0] = (c >> 13) << 5 | ((c >> 8) & 7) << 2 | ((c >> 3) & 3);
+        _read_len = 1;
+      }
+    }
+    return _read_pixel[_read_pos++];
+  }
+
+  void Bus_RA8875::beginRead(uint_fast8_t dummy_bits)
+  {
+    _spi_has_op = false;
+    _spi_stream = false;
+    _dummy_left = (_cur == REG_MRWC) ? (_cfg.dummy_read_pixel >> 3) : 0;
+    _read_pos = _read_len = 0;
+    add_read(dummy_bits);
+    for (; dummy_bits >= 8; dummy_bits -= 8) { read_byte(); }
+  }
+
+  void Bus_RA8875::endRead(void)
+  {
+    _dummy_left = 0;
+  }
+
+  uint32_t Bus_RA8875::readData(uint_fast8_t bit_length)
+  {
+    add_read(bit_length);
+    uint32_t res = 0;
+    for (uint_fast8_t i = 0; i < bit_length; i += 8)
+    {
+      res |= read_byte() << i;
+    }
+    return res;
+  }
+
+  bool Bus_RA8875::readBytes(uint8_t* dst, uint32_t length, bool use_dma)
+  {
+    add_read(length << 3);
+    for (uint32_t i = 0; i < length; ++i) { dst[i] = read_byte(); }
+    return true;
+  }
+
+  void Bus_RA8875::readPixels(void* dst, pixelcopy_t* param, uint32_t length)
+  {
+    uint8_t buf[96];
+    uint32_t bytes = param->src_bits >> 3;
+    uint32_t chunk = sizeof(buf) / bytes;
+    auto src_data = param->src_data;
+    param->src_data = buf;
+    int32_t dstindex = 0;
+    while (length)
+    {
+      uint32_t len = length < chunk ? length : chunk;
+      readBytes(buf, len * bytes, false);
+      param->src_x = 0;
+      dstindex = param->fp_copy(dst, dstindex, dstindex + len, param);
+      length -= len;
+    }
+    param->src_data = src_data;
+  }
+
+//----------------------------------------------------------------------------
+
+  static uint16_t apply_rop(uint_fast8_t rop, uint16_t s, uint16_t d)
+  {
+    switch (rop & 0x0F)
+    {
+    case 0x0: return 0;
+    case 0x1: return ~(s | d);
+    case 0x2: return ~s & d;
+    case 0x3: return ~s;
+    case 0x4: return s & ~d;
+    case 0x5: return ~d;
+    case 0x6: return s ^ d;
+    case 0x7: return ~(s & d);
+    case 0x8: return s & d;
+    case 0x9: return ~(s ^ d);
+    case 0xA: return d;
+    case 0xB: return ~s | d;
+    default:
+    case 0xC: return s;
+    case 0xD: return s | ~d;
+    case 0xE: return s | d;
+    case 0xF: return 0xFFFF;
+    }
+  }
+
+  void Bus_RA8875::exec_bte(void)
+  {
+    ++_engine_count;
+    _reg[0x50] &= ~0x80;
+    int32_t w = reg16(0x5C);
+    int32_t h = reg16(0x5E);
+    int32_t dx = reg16(0x58);
+    int32_t dy = reg16(0x5A);
+    uint_fast8_t op = _reg[0x51] & 0x0F;
+    if (op == 0x0C)
+    { // Solid Fill;
+      fill_rect(dx, dy, w, h, fgcolor());
+      return;
+    }
+    if (op != 0x02 && op != 0x03) { return; }
+
+    // Move BTE : 0x02 は左上から、0x03 は右下から (始点も右下の座標となる) 転送する;
+    int32_t sx = reg16(0x54);
+    int32_t sy = reg16(0x56);
+    int32_t step = (op == 0x02) ? 1 : -1;
+    uint_fast8_t rop = _reg[0x51] >> 4;
+    for (int32_t j = 0; j < h; ++j)
+    {
+      int32_t y0 = sy + j * step;
+      int32_t y1 = dy + j * step;
+      for (int32_t i = 0; i < w; ++i)
+      {
+        int32_t x0 = sx + i * step;
+        int32_t x1 = dx + i * step;
+        if (x0 < 0 || y0 < 0 || x0 >= _cfg.memory_width || y0 >= _cfg.memory_height) { continue; }
+        if (x1 < 0 || y1 < 0 || x1 >= _cfg.memory_width || y1 >= _cfg.memory_height) { continue; }
+        auto d = &_gram[x1 + y1 * _cfg.memory_width];
+        *d = apply_rop(rop, _gram[x0 + y0 * _cfg.memory_width], *d);
+      }
+    }
+  }
+
+  void Bus_RA8875::exec_draw(void)
+  {
+    ++_engine_count;
+    uint_fast8_t dcr = _reg[0x90];
+    _reg[0x90] = dcr & ~0xC0;
+    bool fill = dcr & 0x20;
+    auto color = fgcolor();
+    if (dcr & 0x40)
+    { // Draw Circle;
+      draw_circle(reg16(0x99), reg16(0x9B), _reg[0x9D], color, fill);
+      return;
+    }
+    int32_t x0 = reg16(0x91);
+    int32_t y0 = reg16(0x93);
+    int32_t x1 = reg16(0x95);
+    int32_t y1 = reg16(0x97);
+    if (dcr & 0x01)
+    { // Draw Triangle;
+      draw_triangle(x0, y0, x1, y1, reg16(0xA9), reg16(0xAB), color, fill);
+    }
+    else if (dcr & 0x10)
+    { // Draw Square;
+      if (x0 > x1) { std::swap(x0, x1); }
+      if (y0 > y1) { std::swap(y0, y1); }
+      if (fill)
+      {
+        fill_rect(x0, y0, x1 - x0 + 1, y1 - y0 + 1, color);
+      }
+      else
+      {
+        fill_rect(x0, y0, x1 - x0 + 1, 1, color);
+        fill_rect(x0, y1, x1 - x0 + 1, 1, color);
+        fill_rect(x0, y0, 1, y1 - y0 + 1, color);
+        fill_rect(x1, y0, 1, y1 - y0 + 1, color);
+      }
+    }
+    else
+    { // Draw Line;
+      draw_line(x0, y0, x1, y1, color);
+    }
+  }
+
+  void Bus_RA8875::exec_ellipse(void)
+  {
+    ++_engine_count;
+    uint_fast8_t ecr = _reg[0xA0];
+    _reg[0xA0] = ecr & ~0x80;
+    bool fill = ecr & 0x40;
+    auto color = fgcolor();
+    if (ecr & 0x20)
+    { // Draw Circle Square (角の半径は長軸側の値を用いる);
+      int32_t x0 = reg16(0x91);
+      int32_t y0 = reg16(0x93);
+      int32_t x1 = reg16(0x95);
+      int32_t y1 = reg16(0x97);
+      if (x0 > x1) { std::swap(x0, x1); }
+      if (y0 > y1) { std::swap(y0, y1); }
+      draw_roundrect(x0, y0, x1, y1, reg16(0xA1), color, fill);
+    }
+    else if (!(ecr & 0x10))
+    { // Draw Ellipse (曲線 (0x10) は未対応);
+      draw_ellipse(reg16(0xA5), reg16(0xA7), reg16(0xA1), reg16(0xA3), color, fill);
+    }
+  }
+
+//----------------------------------------------------------------------------
+// 図形の描画規則は LGFXBase と同じ中点・ブレゼンハム法とする;
+
+  void Bus_RA8875::draw_line(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color)
+  {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    if (steep) { std::swap(x0, y0); std::swap(x1, y1); }
+    if (x0 > x1) { std::swap(x0, x1); std::swap(y0, y1); }
+    int32_t dx = x1 - x0;
+    int32_t dy = abs(y1 - y0);
+    int32_t ystep = (y1 > y0) ? 1 : -1;
+    int32_t err = dx >> 1;
+    for (; x0 <= x1; ++x0)
+    {
+      if (steep) { plot(y0, x0, color); }
+      else       { plot(x0, y0, color); }
+      if ((err -= dy) < 0)
+      {
+        err += dx;
+        y0 += ystep;
+      }
+    }
+  }
+
+  void Bus_RA8875::draw_triangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint16_t color, bool fill)
+  {
+    if (!fill)
+    {
+      draw_line(x0, y0, x1, y1, color);
+      draw_line(x1, y1, x2, y2, color);
+      draw_line(x2, y2, x0, y0, color);
+      return;
+    }
+    int32_t a, b;
+    if (y0 > y1) { std::swap(y0, y1); std::swap(x0, x1); }
+    if (y1 > y2) { std::swap(y2, y1); std::swap(x2, x1); }
+    if (y0 > y1) { std::swap(y0, y1); std::swap(x0, x1); }
+
+    if (y0 == y2)
+    {
+      a = std::min(std::min(x0, x1), x2);
+      b = std::max(std::max(x0, x1), x2);
+      fill_rect(a, y0, b - a + 1, 1, color);
+      return;
+    }
+    if ((x1-x0) * (y2-y0) == (x2-x0) * (y1-y0))
+    {
+      draw_line(x0, y0, x2, y2, color);
+      return;
+    }
+
+    int32_t dy1 = y1 - y0;
+    int32_t dy2 = y2 - y0;
+    bool change = ((x1 - x0) * dy2 > (x2 - x0) * dy1);
+    int32_t dx1 = abs(x1 - x0);
+    int32_t dx2 = abs(x2 - x0);
+    int32_t xstep1 = x1 < x0 ? -1 : 1;
+    int32_t xstep2 = x2 < x0 ? -1 : 1;
+    a = b = x0;
+    if (change)
+    {
+      std::swap(dx1, dx2);
+      std::swap(dy1, dy2);
+      std::swap(xstep1, xstep2);
+    }
+    int32_t err1 = (std::max(dx1, dy1) >> 1) + (xstep1 < 0 ? std::min(dx1, dy1) : dx1);
+    int32_t err2 = (std::max(dx2, dy2) >> 1) + (xstep2 > 0 ? std::min(dx2, dy2) : dx2);
+    if (y0 != y1)
+    {
+      do
+      {
+        err1 -= dx1;
+        while (err1 < 0) { err1 += dy1; a += xstep1; }
+        err2 -= dx2;
+        while (err2 < 0) { err2 += dy2; b += xstep2; }
+        fill_rect(a, y0, b - a + 1, 1, color);
+      } while (++y0 < y1);
+    }
+
+    if (change)
+    {
+      b = x1;
+      xstep2 = x2 < x1 ? -1 : 1;
+      dx2 = abs(x2 - x1);
+      dy2 = y2 - y1;
+      err2 = (std::max(dx2, dy2) >> 1) + (xstep2 > 0 ? std::min(dx2, dy2) : dx2);
+    }
+    else
+    {
+      a = x1;
+      dx1 = abs(x2 - x1);
+      dy1 = y2 - y1;
+      xstep1 = x2 < x1 ? -1 : 1;
+      err1 = (std::max(dx1, dy1) >> 1) + (xstep1 < 0 ? std::min(dx1, dy1) : dx1);
+    }
+    do
+    {
+      err1 -= dx1;
+      while (err1 < 0) { err1 += dy1; if ((a += xstep1) == x2) break; }
+      err2 -= dx2;
+      while (err2 < 0) { err2 += dy2; if ((b += xstep2) == x2) break; }
+      fill_rect(a, y0, b - a + 1, 1, color);
+    } while (++y0 <= y2);
+  }
+
+  void Bus_RA8875::draw_circle(int32_t x, int32_t y, int32_t r, uint16_t color, bool fill)
+  {
+    if (r <= 0)
+    {
+      plot(x, y, color);
+      return;
+    }
+    int32_t f = 1 - r;
+    int32_t ddF_y = - (r << 1);
+    int32_t ddF_x = 1;
+    int32_t i = 0;
+    if (fill)
+    {
+      fill_rect(x - r, y, (r << 1) + 1, 1, color);
+      do
+      {
+        int32_t len = 0;
+        while (f < 0) { f += (ddF_x += 2); ++len; }
+        i += len;
+        f += (ddF_y += 2);
+        if (len) fill_rect(x - r, y + i - len + 1, (r << 1) + 1, len, color);
+        fill_rect(x - i, y + r, (i << 1) + 1, 1, color);
+        fill_rect(x - i, y - r, (i << 1) + 1, 1, color);
+        if (len) fill_rect(x - r, y - i, (r << 1) + 1, len, color);
+      } while (i < --r);
+      return;
+    }
+    int32_t j = -1;
+    do
+    {
+      while (f < 0) { ++i; f += (ddF_x += 2); }
+      f += (ddF_y += 2);
+      fill_rect(x - i    , y + r, i - j, 1, color);
+      fill_rect(x - i    , y - r, i - j, 1, color);
+      fill_rect(x + j + 1, y - r, i - j, 1, color);
+      fill_rect(x + j + 1, y + r, i - j, 1, color);
+      fill_rect(x + r, y + j + 1, 1, i - j, color);
+      fill_rect(x + r, y - i    , 1, i - j, color);
+      fill_rect(x - r, y - i    , 1, i - j, color);
+      fill_rect(x - r, y + j + 1, 1, i - j, color);
+      j = i;
+    } while (i < --r);
+  }
+
+  void Bus_RA8875::draw_ellipse(int32_t x, int32_t y, int32_t rx, int32_t ry, uint16_t color, bool fill)
+  {
+    if (rx <= 0 || ry <= 0)
+    {
+      fill_rect(x - rx, y - ry, (rx << 1) + 1, (ry << 1) + 1, color);
+      return;
+    }
+    int32_t xt, yt, s, i;
+    int32_t rx2 = rx * rx;
+    int32_t ry2 = ry * ry;
+
+    if (fill)
+    {
+      fill_rect(x - rx, y, (rx << 1) + 1, 1, color);
+      i = 0;
+      yt = 0;
+      xt = rx;
+      s = (rx2 << 1) + ry2 * (1 - (rx << 1));
+      do
+      {
+        while (s < 0) s += rx2 * ((++yt << 2) + 2);
+        fill_rect(x - xt, y - yt   , (xt << 1) + 1, yt - i, color);
+        fill_rect(x - xt, y + i + 1, (xt << 1) + 1, yt - i, color);
+        i = yt;
+        s -= (--xt) * ry2 << 2;
+      } while (rx2 * yt <= ry2 * xt);
+
+      xt = 0;
+      yt = ry;
+      s = (ry2 << 1) + rx2 * (1 - (ry << 1));
+      do
+      {
+        while (s < 0) s += ry2 * ((++xt << 2) + 2);
+        fill_rect(x - xt, y - yt, (xt << 1) + 1, 1, color);
+        fill_rect(x - xt, y + yt, (xt << 1) + 1, 1, color);
+        s -= (--yt) * rx2 << 2;
+      } while (ry2 * xt <= rx2 * yt);
+      return;
+    }
+
+    i = -1;
+    xt = 0;
+    yt = ry;
+    s = (ry2 << 1) + rx2 * (1 - (ry << 1));
+    do
+    {
+      while (s < 0) s += ry2 * ((++xt << 2) + 2);
+      fill_rect(x - xt   , y - yt, xt - i, 1, color);
+      fill_rect(x + i + 1, y - yt, xt - i, 1, color);
+      fill_rect(x + i + 1, y + yt, xt - i, 1, color);
+      fill_rect(x - xt   , y + yt, xt - i, 1, color);
+      i = xt;
+      s -= (--yt) * rx2 << 2;
+    } while (ry2 * xt <= rx2 * yt);
+
+    i = -1;
+    yt = 0;
+    xt = rx;
+    s = (rx2 << 1) + ry2 * (1 - (rx << 1));
+    do
+    {
+      while (s < 0) s += rx2 * ((++yt << 2) + 2);
+      fill_rect(x - xt, y - yt   , 1, yt - i, color);
+      fill_rect(x - xt, y + i + 1, 1, yt - i, color);
+      fill_rect(x + xt, y + i + 1, 1, yt - i, color);
+      fill_rect(x + xt, y - yt   , 1, yt - i, color);
+      i = yt;
+      s -= (--xt) * ry2 << 2;
+    } while (rx2 * yt <= ry2 * xt);
+  }
+
+  void Bus_RA8875::draw_roundrect(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t r, uint16_t color, bool fill)
+  {
+    int32_t x = x0;
+    int32_t y = y0;
+    int32_t w = x1 - x0 + 1;
+    int32_t h = y1 - y0 + 1;
+    int32_t f     = 1 - r;
+    int32_t ddF_x = 1;
+    int32_t ddF_y = - (r << 1);
+    int32_t len = 0;
+    if (fill)
+    {
+      int32_t ya = y + r;
+      int32_t yb = y + h - r - 1;
+      int32_t delta = w + ddF_y;
+      fill_rect(x, ya, w, h + ddF_y, color);
+      int32_t xa = x + r;
+      for (int32_t i = 0; i <= r; i++)
+      {
+        len++;
+        if (f >= 0)
+        {
+          fill_rect(xa - r, ya - i          , (r << 1) + delta, len, color);
+          fill_rect(xa - r, yb + i - len + 1, (r << 1) + delta, len, color);
+          if (i == r) break;
+          len = 0;
+          fill_rect(xa - i, yb + r, (i << 1) + delta, 1, color);
+          ddF_y += 2;
+          f     += ddF_y;
+          fill_rect(xa - i, ya - r, (i << 1) + delta, 1, color);
+          r--;
+        }
+        ddF_x += 2;
+        f     += ddF_x;
+      }
+      return;
+    }
+
+    w--;
+    h--;
+    len = (r << 1) + 1;
+    int32_t yb = y + h - r;
+    int32_t ya = y + r;
+    fill_rect(x    , ya + 1, 1, h - len, color);
+    fill_rect(x + w, ya + 1, 1, h - len, color);
+    int32_t xb = x + w - r;
+    int32_t xa = x + r;
+    fill_rect(xa + 1, y    , w - len, 1, color);
+    fill_rect(xa + 1, y + h, w - len, 1, color);
+
+    len = 0;
+    for (int32_t i = 0; i <= r; i++)
+    {
+      len++;
+      if (f >= 0)
+      {
+        fill_rect(xa - i          , ya - r, len, 1, color);
+        fill_rect(xa - i          , yb + r, len, 1, color);
+        fill_rect(xb + i - len + 1, yb + r, len, 1, color);
+        fill_rect(xb + i - len + 1, ya - r, len, 1, color);
+        fill_rect(xb + r, yb + i - len + 1, 1, len, color);
+        fill_rect(xa - r, yb + i - len + 1, 1, len, color);
+        fill_rect(xb + r, ya - i, 1, len, color);
+        fill_rect(xa - r, ya - i, 1, len, color);
+        len = 0;
+        r--;
+        ddF_y += 2;
+        f     += ddF_y;
+      }
+      ddF_x += 2;
+      f     += ddF_x;
+    }
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
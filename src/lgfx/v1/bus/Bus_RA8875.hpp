@@ -0,0 +1,166 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "../Bus.hpp"
+#include "../platforms/common.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// RA8875 をレジスタ単位で模倣するバス。;
+  /// メモリ書込み・読出し、BTE (塗り潰し・移動) と図形描画エンジン (直線・矩形・三角形・円・楕円・角丸矩形) を;
+  /// メモリ上のGRAMに反映し、設定したクロックとバス幅から通信時間を見積もる (描画エンジンの処理時間は含まない);
+  /// 図形の描き方は LGFXBase と同じ規則をパネル上の座標に適用したもので、実機の結果と一致する保証はない;
+  /// 回転 0 と 6 ではソフトウェア描画と一致するが、それ以外の回転では直線・三角形の辺で数画素から数十画素の差が出る;
+  /// 使い方: _ra8875.config(cfg); _panel_instance.setBus(&_ra8875);
+  class Bus_RA8875 : public IBus
+  {
+  public:
+    struct config_t
+    {
+      /// GRAMの大きさ (Panel の memory_width / memory_height に合わせる);
+      uint16_t memory_width = 800;
+      uint16_t memory_height = 480;
+
+      uint32_t freq_write = 20000000;
+      uint32_t freq_read  = 10000000;
+
+      /// 1:SPI 8:8bitパラレル 16:16bitパラレル;
+      uint8_t bus_width = 1;
+
+      /// パラレル接続でレジスタを16bit単位で受け取る (Panel の dlen_16bit に合わせる);
+      bool dlen_16bit = false;
+
+      /// メモリ読出しの応答の前に出力するダミーのビット数 (8の倍数。Panel の dummy_read_pixel に相当);
+      uint8_t dummy_read_pixel = 16;
+    };
+
+    Bus_RA8875(void);
+    virtual ~Bus_RA8875(void) { release(); }
+
+    const config_t& config(void) const { return _cfg; }
+    void config(const config_t& cfg);
+
+    bus_type_t busType(void) const override { return _cfg.bus_width == 1 ? bus_spi : (_cfg.bus_width == 8 ? bus_parallel8 : bus_parallel16); }
+    bool init(void) override;
+    void release(void) override;
+    uint32_t getClock(void) const override { return _cfg.freq_write; }
+    void setClock(uint32_t freq) override { _cfg.freq_write = freq; }
+
+    void beginTransaction(void) override {}
+    void endTransaction(void) override {}
+    void wait(void) override {}
+    bool busy(void) const override { return false; }
+
+    void initDMA(void) override {}
+    void addDMAQueue(const uint8_t* data, uint32_t length) override { writeBytes(data, length, true, true); }
+    void execDMAQueue(void) override {}
+    uint8_t* getDMABuffer(uint32_t length) override { return _flip_buffer.getBuffer(length); }
+
+    void flush(void) override {}
+    bool writeCommand(uint32_t data, uint_fast8_t bit_length) override;
+    void writeData(uint32_t data, uint_fast8_t bit_length) override;
+    void writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count) override;
+    void writePixels(pixelcopy_t* pc, uint32_t length) override;
+    void writeBytes(const uint8_t* data, uint32_t length, bool dc, bool use_dma) override;
+
+    void beginRead(uint_fast8_t dummy_bits) override;
+    void beginRead(void) override { beginRead(0); }
+    void endRead(void) override;
+    uint32_t readData(uint_fast8_t bit_length) override;
+    bool readBytes(uint8_t* dst, uint32_t length, bool use_dma) override;
+    void readPixels(void* dst, pixelcopy_t* pc, uint32_t length) override;
+
+    /// ハードウェアリセット相当 (GRAMの内容は保持する);
+    void reset(void);
+
+    /// GRAMの内容 (1画素 RGB565。256色モードで書き込んだ画素も RGB565 に拡張して保持する);
+    const uint16_t* getGRAM(void) const { return _gram; }
+    /// 0xRRGGBB 形式で返す;
+    uint32_t readGRAM(uint_fast16_t x, uint_fast16_t y) const;
+
+    uint8_t getReg(uint8_t reg) const { return _reg[reg]; }
+
+    /// レジスタへの書込み回数と、BTE・図形描画エンジンの実行回数 (reset からの累計);
+    uint32_t getRegWriteCount(void) const { return _reg_writes; }
+    uint32_t getEngineCount(void) const { return _engine_count; }
+
+    /// 通信時間の見積り (reset / resetWireTime からの累計);
+    uint32_t getWireUsec(void) const;
+    uint64_t getWriteBytes(void) const { return _write_bytes; }
+    uint64_t getReadBytes(void) const { return _read_bytes; }
+    void resetWireTime(void);
+
+  protected:
+    config_t _cfg;
+    FlipBuffer _flip_buffer;
+    uint16_t* _gram = nullptr;
+    uint64_t _write_cycles = 0;
+    uint64_t _read_cycles = 0;
+    uint64_t _write_bytes = 0;
+    uint64_t _read_bytes = 0;
+    uint32_t _reg_writes = 0;
+    uint32_t _engine_count = 0;
+
+    uint8_t _reg[256];
+    uint8_t _cur = 0;         // 選択中のレジスタ;
+    uint8_t _spi_op = 0;      // SPI : 直前に受け取った先頭バイト (0x80:コマンド 0x00:データ書込 0x40:データ読出);
+    bool _spi_has_op = false; // SPI : 先頭バイトを受け取り、続くバイトを待っている;
+    bool _spi_stream = false; // SPI : データ書込の先頭バイトの後、連続してデータを受け取る;
+    uint16_t _wx, _wy;        // メモリ書込み位置;
+    uint16_t _rx, _ry;        // メモリ読出し位置;
+    uint8_t _pixel_hi;
+    uint8_t _pixel_len = 0;
+    uint8_t _read_pixel[2];
+    uint8_t _read_pos = 0;
+    uint8_t _read_len = 0;
+    uint16_t _dummy_left = 0;
+
+    void add_write(uint32_t bits, uint32_t count = 1);
+    void add_read(uint32_t bits);
+    void put_byte(uint8_t data);
+    void put_spi(uint8_t data);
+    void put_pixel(uint8_t data);
+    void write_reg(uint8_t reg, uint8_t data);
+    uint8_t read_byte(void);
+
+    bool is_16bpp(void) const { return _reg[0x10] & 0x08; }
+    uint16_t fgcolor(void) const;
+    uint_fast16_t reg16(uint8_t reg, uint_fast16_t mask = 0x3FF) const { return (_reg[reg] | _reg[reg + 1] << 8) & mask; }
+    /// メモリの読み書き位置を進める (dir : 0:左→右 1:右→左 2:上→下 3:下→上);
+    void next_pos(uint16_t& x, uint16_t& y, uint_fast8_t dir) const;
+
+    void plot(int32_t x, int32_t y, uint16_t color);
+    void fill_rect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+    void draw_line(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint16_t color);
+    void draw_triangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint16_t color, bool fill);
+    void draw_circle(int32_t x, int32_t y, int32_t r, uint16_t color, bool fill);
+    void draw_ellipse(int32_t x, int32_t y, int32_t rx, int32_t ry, uint16_t color, bool fill);
+    void draw_roundrect(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t r, uint16_t color, bool fill);
+    void exec_bte(void);
+    void exec_draw(void);
+    void exec_ellipse(void);
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -0,0 +1,240 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#include "Bus_Stats.hpp"
+
+#include "../misc/pixelcopy.hpp"
+#include "../platforms/common.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  void bus_stats_t::clear(void)
+  {
+    memset(this, 0, sizeof(bus_stats_t));
+  }
+
+  uint32_t bus_stats_t::busUsec(void) const
+  {
+    uint32_t res = 0;
+    for (size_t i = 0; i < call_max; ++i) { res += usec[i]; }
+    return res;
+  }
+
+  int bus_stats_t::print(char* buf, size_t len) const
+  {
+    // 2A:CASET 2B:RASET 2C:RAMWR (MIPI DCS);
+    return snprintf(buf, len
+      , "cmd %lu(2A:%lu 2B:%lu 2C:%lu) data %luB rep %lupx pix %lupx dma %lu/%luB wait %lu/%lu tr %lu rd %luB"
+        " | us cmd %lu data %lu rep %lu pix %lu dma %lu wait %lu rd %lu tr %lu | bus %lu/%luus"
+      , (unsigned long)calls[call_command]
+      , (unsigned long)commands[0x2A], (unsigned long)commands[0x2B], (unsigned long)commands[0x2C]
+      , (unsigned long)data_bytes, (unsigned long)repeat_pixels, (unsigned long)pixels
+      , (unsigned long)dma_queues, (unsigned long)dma_bytes
+      , (unsigned long)wait_stalls, (unsigned long)calls[call_wait]
+      , (unsigned long)transactions, (unsigned long)read_bytes
+      , (unsigned long)usec[call_command], (unsigned long)usec[call_data]
+      , (unsigned long)usec[call_repeat], (unsigned long)usec[call_pixels]
+      , (unsigned long)usec[call_dma], (unsigned long)usec[call_wait]
+      , (unsigned long)usec[call_read], (unsigned long)usec[call_transaction]
+      , (unsigned long)busUsec(), (unsigned long)period_usec
+      );
+  }
+
+//----------------------------------------------------------------------------
+
+  uint32_t Bus_Stats::start(void) const
+  {
+    return _timing ? micros() : 0;
+  }
+
+  void Bus_Stats::stop(bus_stats_t::call_t call, uint32_t start_usec)
+  {
+    ++_stats.calls[call];
+    if (_timing) { _stats.usec[call] += micros() - start_usec; }
+  }
+
+  void Bus_Stats::resetStats(void)
+  {
+    _stats.clear();
+    _period_start = micros();
+  }
+
+  void Bus_Stats::takeStats(bus_stats_t* dst)
+  {
+    _stats.period_usec = micros() - _period_start;
+    memcpy(dst, &_stats, sizeof(bus_stats_t));
+    resetStats();
+  }
+
+  bool Bus_Stats::init(void)
+  {
+    resetStats();
+    return _bus->init();
+  }
+
+  void Bus_Stats::beginTransaction(void)
+  {
+    auto t = start();
+    _bus->beginTransaction();
+    stop(bus_stats_t::call_transaction, t);
+  }
+
+  void Bus_Stats::endTransaction(void)
+  {
+    auto t = start();
+    _bus->endTransaction();
+    stop(bus_stats_t::call_transaction, t);
+    ++_stats.transactions;
+  }
+
+  void Bus_Stats::wait(void)
+  {
+    if (_bus->busy()) { ++_stats.wait_stalls; }
+    auto t = start();
+    _bus->wait();
+    stop(bus_stats_t::call_wait, t);
+  }
+
+  void Bus_Stats::flush(void)
+  {
+    auto t = start();
+    _bus->flush();
+    stop(bus_stats_t::call_wait, t);
+  }
+
+  void Bus_Stats::addDMAQueue(const uint8_t* data, uint32_t length)
+  {
+    ++_stats.dma_queues;
+    _stats.dma_bytes += length;
+    _stats.data_bytes += length;
+    auto t = start();
+    _bus->addDMAQueue(data, length);
+    stop(bus_stats_t::call_dma, t);
+  }
+
+  void Bus_Stats::execDMAQueue(void)
+  {
+    auto t = start();
+    _bus->execDMAQueue();
+    stop(bus_stats_t::call_dma, t);
+  }
+
+  bool Bus_Stats::writeCommand(uint32_t data, uint_fast8_t bit_length)
+  {
+    ++_stats.commands[data & 0xFF];
+    auto t = start();
+    auto res = _bus->writeCommand(data, bit_length);
+    stop(bus_stats_t::call_command, t);
+    return res;
+  }
+
+  void Bus_Stats::writeData(uint32_t data, uint_fast8_t bit_length)
+  {
+    _stats.data_bytes += bit_length >> 3;
+    auto t = start();
+    _bus->writeData(data, bit_length);
+    stop(bus_stats_t::call_data, t);
+  }
+
+  void Bus_Stats::writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count)
+  {
+    _stats.repeat_pixels += count;
+    _stats.data_bytes += (bit_length >> 3) * count;
+    auto t = start();
+    _bus->writeDataRepeat(data, bit_length, count);
+    stop(bus_stats_t::call_repeat, t);
+  }
+
+  void Bus_Stats::writePixels(pixelcopy_t* pc, uint32_t length)
+  {
+    _stats.pixels += length;
+    _stats.data_bytes += (pc->dst_bits * length) >> 3;
+    auto t = start();
+    _bus->writePixels(pc, length);
+    stop(bus_stats_t::call_pixels, t);
+  }
+
+  void Bus_Stats::writeBytes(const uint8_t* data, uint32_t length, bool dc, bool use_dma)
+  {
+    if (dc) { _stats.data_bytes += length; }
+    if (use_dma)
+    {
+      ++_stats.dma_queues;
+      _stats.dma_bytes += length;
+    }
+    auto t = start();
+    _bus->writeBytes(data, length, dc, use_dma);
+    stop(use_dma ? bus_stats_t::call_dma : bus_stats_t::call_data, t);
+  }
+
+  void Bus_Stats::beginRead(uint_fast8_t dummy_bits)
+  {
+    auto t = start();
+    _bus->beginRead(dummy_bits);
+    stop(bus_stats_t::call_read, t);
+  }
+
+  void Bus_Stats::beginRead(void)
+  {
+    auto t = start();
+    _bus->beginRead();
+    stop(bus_stats_t::call_read, t);
+  }
+
+  void Bus_Stats::endRead(void)
+  {
+    auto t = start();
+    _bus->endRead();
+    stop(bus_stats_t::call_read, t);
+  }
+
+  uint32_t Bus_Stats::readData(uint_fast8_t bit_length)
+  {
+    _stats.read_bytes += bit_length >> 3;
+    auto t = start();
+    auto res = _bus->readData(bit_length);
+    stop(bus_stats_t::call_read, t);
+    return res;
+  }
+
+  bool Bus_Stats::readBytes(uint8_t* dst, uint32_t length, bool use_dma)
+  {
+    _stats.read_bytes += length;
+    auto t = start();
+    auto res = _bus->readBytes(dst, length, use_dma);
+    stop(bus_stats_t::call_read, t);
+    return res;
+  }
+
+  void Bus_Stats::readPixels(void* dst, pixelcopy_t* pc, uint32_t length)
+  {
+    _stats.read_bytes += (pc->src_bits * length) >> 3;
+    auto t = start();
+    _bus->readPixels(dst, pc, length);
+    stop(bus_stats_t::call_read, t);
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
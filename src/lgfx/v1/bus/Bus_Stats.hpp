@@ -0,0 +1,130 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include <stddef.h>
+
+#include "../Bus.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  struct bus_stats_t
+  {
+    enum call_t
+    { call_command
+    , call_data         // writeData / writeBytes
+    , call_repeat       // writeDataRepeat
+    , call_pixels       // writePixels
+    , call_dma          // addDMAQueue / execDMAQueue
+    , call_wait         // wait / flush
+    , call_read         // beginRead ~ endRead
+    , call_transaction  // beginTransaction / endTransaction
+    , call_max
+    };
+
+    uint32_t calls[call_max];
+    uint32_t usec[call_max];  // 呼出し種別毎の所要時間;
+    uint32_t data_bytes;      // D/C=high で送信したバイト数 (writeDataRepeat, writePixels, DMAを含む);
+    uint32_t repeat_pixels;   // writeDataRepeat の繰返し回数;
+    uint32_t pixels;          // writePixels の画素数;
+    uint32_t dma_queues;      // addDMAQueue の回数;
+    uint32_t dma_bytes;
+    uint32_t wait_stalls;     // 通信中に wait が呼ばれた回数;
+    uint32_t read_bytes;
+    uint32_t transactions;    // beginTransaction ~ endTransaction の組の数;
+    uint32_t period_usec;     // 計測期間;
+    uint32_t commands[256];   // コマンド (下位8bit) 毎の送信回数;
+
+    void clear(void);
+
+    /// バスの処理に費やした時間の合計;
+    uint32_t busUsec(void) const;
+
+    /// 1行の文字列にまとめる。戻り値は snprintf と同様;
+    int print(char* buf, size_t len) const;
+  };
+
+  /// 別のバスへの呼出しを中継し、呼出し回数・転送量・所要時間を集計するバス。;
+  /// 使い方: _bus_instance.config(cfg); _stats.setBus(&_bus_instance); _panel_instance.setBus(&_stats);
+  class Bus_Stats : public IBus
+  {
+  public:
+    Bus_Stats(void) { _stats.clear(); }
+    Bus_Stats(IBus* bus) : Bus_Stats() { _bus = bus; }
+
+    void setBus(IBus* bus) { _bus = bus; }
+    IBus* getBus(void) const { return _bus; }
+
+    /// 呼出し毎の時間計測の有無 (計測しない場合は回数と転送量のみ集計する);
+    void setTiming(bool enable) { _timing = enable; }
+
+    /// 集計中の値を参照する;
+    const bus_stats_t& getStats(void) const { return _stats; }
+
+    /// 集計した値を dst にコピーして集計をやり直す。フレーム毎に呼び出すことを想定;
+    void takeStats(bus_stats_t* dst);
+
+    void resetStats(void);
+
+    bus_type_t busType(void) const override { return _bus->busType(); }
+    bool init(void) override;
+    void release(void) override { _bus->release(); }
+    uint32_t getClock(void) const override { return _bus->getClock(); }
+    void setClock(uint32_t freq) override { _bus->setClock(freq); }
+
+    void beginTransaction(void) override;
+    void endTransaction(void) override;
+    void wait(void) override;
+    bool busy(void) const override { return _bus->busy(); }
+
+    void initDMA(void) override { _bus->initDMA(); }
+    void addDMAQueue(const uint8_t* data, uint32_t length) override;
+    void execDMAQueue(void) override;
+    uint8_t* getDMABuffer(uint32_t length) override { return _bus->getDMABuffer(length); }
+
+    void flush(void) override;
+    bool writeCommand(uint32_t data, uint_fast8_t bit_length) override;
+    void writeData(uint32_t data, uint_fast8_t bit_length) override;
+    void writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count) override;
+    void writePixels(pixelcopy_t* pc, uint32_t length) override;
+    void writeBytes(const uint8_t* data, uint32_t length, bool dc, bool use_dma) override;
+
+    void beginRead(uint_fast8_t dummy_bits) override;
+    void beginRead(void) override;
+    void endRead(void) override;
+    uint32_t readData(uint_fast8_t bit_length) override;
+    bool readBytes(uint8_t* dst, uint32_t length, bool use_dma) override;
+    void readPixels(void* dst, pixelcopy_t* pc, uint32_t length) override;
+
+  protected:
+    IBus* _bus = nullptr;
+    bus_stats_t _stats;
+    uint32_t _period_start = 0;
+    bool _timing = true;
+
+    uint32_t start(void) const;
+    void stop(bus_stats_t::call_t call, uint32_t start_usec);
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -0,0 +1,488 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#include "Bus_Trace.hpp"
+
+#include "../misc/pixelcopy.hpp"
+#include "../platforms/common.hpp"
+
+#include <string.h>
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  using namespace bus_trace;
+
+  static constexpr uint8_t trace_magic[4] = { 'L', 'G', 'B', 'T' };
+
+  bool bus_trace_reader_t::begin(const uint8_t* data, uint32_t length)
+  {
+    _data = data;
+    _length = length;
+    _pos = 0;
+    _usec = 0;
+    _error = false;
+    if (length < 6 || memcmp(data, trace_magic, 4) || data[4] != bus_trace::version)
+    {
+      _error = true;
+      _length = 0;
+      return false;
+    }
+    _bus_type = (bus_type_t)data[5];
+    _pos = 6;
+    return true;
+  }
+
+  bool bus_trace_reader_t::read_varint(uint32_t* value)
+  {
+    uint32_t res = 0;
+    uint_fast8_t shift = 0;
+    do
+    {
+      if (_pos >= _length || shift > 28) { return false; }
+      uint8_t b = _data[_pos++];
+      res |= (uint32_t)(b & 0x7F) << shift;
+      if (!(b & 0x80)) { break; }
+      shift += 7;
+    } while (true);
+    *value = res;
+    return true;
+  }
+
+  bool bus_trace_reader_t::next(bus_trace_record_t* record)
+  {
+    if (_pos >= _length) { return false; }
+    memset(record, 0, sizeof(bus_trace_record_t));
+    uint8_t op = _data[_pos++];
+    uint32_t delta;
+    bool res = (op != op_none && op < op_max) && read_varint(&delta);
+    if (res)
+    {
+      _usec += delta;
+      record->op = (op_t)op;
+      record->delta_usec = delta;
+      record->usec = _usec;
+      switch (op)
+      {
+      case op_command:
+      case op_data:
+      case op_repeat:
+      case op_pixels:
+      case op_read_begin:
+        res = _pos < _length;
+        if (!res) { break; }
+        record->bits = _data[_pos++];
+        if (op == op_read_begin) { break; }
+        if (op == op_pixels)
+        {
+          res = read_varint(&record->count);
+          record->length = (record->bits * record->count + 7) >> 3;
+          break;
+        }
+        {
+          uint_fast8_t bytes = (record->bits + 7) >> 3;
+          res = (bytes <= 4) && (_pos + bytes <= _length);
+          if (!res) { break; }
+          uint32_t value = 0;
+          for (uint_fast8_t i = 0; i < bytes; ++i) { value |= _data[_pos++] << (i * 8); }
+          record->value = value;
+        }
+        if (op == op_repeat) { res = read_varint(&record->count); }
+        break;
+
+      case op_bytes:
+        res = _pos < _length;
+        if (!res) { break; }
+        record->flags = _data[_pos++];
+        // fall through
+      case op_dma_queue:
+        res = read_varint(&record->length);
+        break;
+
+      case op_read:
+        res = read_varint(&record->length);
+        break;
+
+      case op_clock:
+      case op_mark:
+        res = read_varint(&record->value);
+        break;
+
+      default:
+        break;
+      }
+      if (res && record->length && op != op_read)
+      {
+        res = (record->length <= _length - _pos);
+        record->payload = &_data[_pos];
+        if (res) { _pos += record->length; }
+      }
+    }
+    if (!res)
+    {
+      _error = true;
+      _length = 0;
+    }
+    return res;
+  }
+
+  void bus_trace_reader_t::replay(const bus_trace_record_t& record, IBus* bus)
+  {
+    switch (record.op)
+    {
+    case op_command:    bus->writeCommand(record.value, record.bits); break;
+    case op_data:       bus->writeData(record.value, record.bits); break;
+    case op_repeat:     bus->writeDataRepeat(record.value, record.bits, record.count); break;
+    case op_bytes:      bus->writeBytes(record.payload, record.length, record.flags & 1, record.flags & 2); break;
+    case op_pixels:     bus->writeBytes(record.payload, record.length, true, false); break;
+    case op_dma_queue:  bus->addDMAQueue(record.payload, record.length); break;
+    case op_dma_exec:   bus->execDMAQueue(); break;
+    case op_begin:      bus->beginTransaction(); break;
+    case op_end:        bus->endTransaction(); break;
+    case op_wait:       bus->wait(); break;
+    case op_read_begin: bus->beginRead(record.bits); break;
+    case op_read_end:   bus->endRead(); break;
+    case op_clock:      bus->setClock(record.value); break;
+    case op_read:
+      {
+        uint8_t buf[64];
+        uint32_t length = record.length;
+        while (length)
+        {
+          uint32_t l = length < sizeof(buf) ? length : sizeof(buf);
+          bus->readBytes(buf, l, false);
+          length -= l;
+        }
+      }
+      break;
+
+    default:
+      break;
+    }
+  }
+
+//----------------------------------------------------------------------------
+
+  Bus_Trace::~Bus_Trace(void)
+  {
+    endTrace();
+    if (_buf) { heap_free(_buf); }
+  }
+
+  void Bus_Trace::setBus(IBus* bus)
+  {
+    static Bus_NULL nullobj;
+    _bus = bus ? bus : &nullobj;
+  }
+
+  bool Bus_Trace::beginTrace(uint32_t buffer_length, output_cb_t output, void* user_data)
+  {
+    endTrace();
+    if (buffer_length < 16) { buffer_length = 16; }
+    if (_buf_len != buffer_length)
+    {
+      if (_buf) { heap_free(_buf); }
+      _buf = (uint8_t*)heap_alloc(buffer_length);
+      _buf_len = _buf ? buffer_length : 0;
+    }
+    if (_buf == nullptr) { return false; }
+
+    _output = output;
+    _user_data = user_data;
+    _len = 0;
+    _rep_count = 0;
+    _overflow = false;
+    _tracing = true;
+    put(trace_magic, sizeof(trace_magic));
+    put_byte(bus_trace::version);
+    put_byte(_bus->busType());
+    _last_usec = micros();
+    return true;
+  }
+
+  void Bus_Trace::endTrace(void)
+  {
+    if (!_tracing) { return; }
+    flushTrace();
+    _tracing = false;
+  }
+
+  void Bus_Trace::flushTrace(void)
+  {
+    flush_repeat();
+    if (_output && _len)
+    {
+      _output(_user_data, _buf, _len);
+      _len = 0;
+    }
+  }
+
+  void Bus_Trace::mark(uint32_t id)
+  {
+    flush_repeat();
+    if (begin_record(op_mark, micros())) { put_varint(id); }
+  }
+
+  bool Bus_Trace::begin_record(op_t op, uint32_t usec)
+  {
+    if (!_tracing) { return false; }
+    _rec_start = _len;
+    put_byte(op);
+    put_varint(usec - _last_usec);
+    _last_usec = usec;
+    return _tracing;
+  }
+
+  void Bus_Trace::put(const void* data, uint32_t length)
+  {
+    auto src = (const uint8_t*)data;
+    while (_tracing && length)
+    {
+      uint32_t space = _buf_len - _len;
+      if (space == 0)
+      {
+        if (_output == nullptr)
+        { // 記録しきれない場合は書きかけの記録を取り消して記録を止める;
+          _len = _rec_start;
+          _overflow = true;
+          _tracing = false;
+          return;
+        }
+        _output(_user_data, _buf, _len);
+        _len = 0;
+        _rec_start = 0;
+        space = _buf_len;
+      }
+      uint32_t l = length < space ? length : space;
+      memcpy(&_buf[_len], src, l);
+      _len += l;
+      src += l;
+      length -= l;
+    }
+  }
+
+  void Bus_Trace::put_varint(uint32_t value)
+  {
+    uint8_t buf[5];
+    uint_fast8_t len = 0;
+    while (value >= 0x80)
+    {
+      buf[len++] = value | 0x80;
+      value >>= 7;
+    }
+    buf[len++] = value;
+    put(buf, len);
+  }
+
+  void Bus_Trace::put_value(uint32_t value, uint_fast8_t bit_length)
+  {
+    uint8_t buf[4];
+    uint_fast8_t len = (bit_length + 7) >> 3;
+    if (len > 4) { len = 4; }
+    for (uint_fast8_t i = 0; i < len; ++i) { buf[i] = value >> (i * 8); }
+    put(buf, len);
+  }
+
+  void Bus_Trace::record(op_t op)
+  {
+    flush_repeat();
+    begin_record(op, micros());
+  }
+
+  void Bus_Trace::put_data(uint32_t data, uint_fast8_t bit_length)
+  {
+    put_byte(bit_length);
+    put_value(data, bit_length);
+  }
+
+  void Bus_Trace::record_bytes(op_t op, const uint8_t* data, uint32_t length, uint8_t flags)
+  {
+    flush_repeat();
+    if (!begin_record(op, micros())) { return; }
+    if (op == op_bytes) { put_byte(flags); }
+    put_varint(length);
+    put(data, length);
+  }
+
+  void Bus_Trace::record_read(uint32_t length)
+  {
+    flush_repeat();
+    if (begin_record(op_read, micros())) { put_varint(length); }
+  }
+
+  void Bus_Trace::fold_repeat(uint32_t data, uint_fast8_t bit_length, uint32_t count)
+  {
+    if (!_tracing) { return; }
+    if (_rep_count && _rep_bits == bit_length && _rep_value == data)
+    {
+      _rep_count += count;
+      return;
+    }
+    flush_repeat();
+    _rep_value = data;
+    _rep_bits = bit_length;
+    _rep_count = count;
+    _rep_usec = micros();
+  }
+
+  void Bus_Trace::flush_repeat(void)
+  {
+    if (!_rep_count) { return; }
+    uint32_t count = _rep_count;
+    _rep_count = 0;
+    op_t op = (count == 1) ? op_data : op_repeat;
+    if (!begin_record(op, _rep_usec)) { return; }
+    put_data(_rep_value, _rep_bits);
+    if (op == op_repeat) { put_varint(count); }
+  }
+
+//----------------------------------------------------------------------------
+
+  void Bus_Trace::setClock(uint32_t freq)
+  {
+    flush_repeat();
+    if (begin_record(op_clock, micros())) { put_varint(freq); }
+    _bus->setClock(freq);
+  }
+
+  void Bus_Trace::beginTransaction(void)
+  {
+    record(op_begin);
+    _bus->beginTransaction();
+  }
+
+  void Bus_Trace::endTransaction(void)
+  {
+    record(op_end);
+    _bus->endTransaction();
+  }
+
+  void Bus_Trace::wait(void)
+  {
+    record(op_wait);
+    _bus->wait();
+  }
+
+  void Bus_Trace::flush(void)
+  {
+    record(op_wait);
+    _bus->flush();
+  }
+
+  void Bus_Trace::addDMAQueue(const uint8_t* data, uint32_t length)
+  {
+    record_bytes(op_dma_queue, data, length, 0);
+    _bus->addDMAQueue(data, length);
+  }
+
+  void Bus_Trace::execDMAQueue(void)
+  {
+    record(op_dma_exec);
+    _bus->execDMAQueue();
+  }
+
+  bool Bus_Trace::writeCommand(uint32_t data, uint_fast8_t bit_length)
+  {
+    flush_repeat();
+    if (begin_record(op_command, micros())) { put_data(data, bit_length); }
+    return _bus->writeCommand(data, bit_length);
+  }
+
+  void Bus_Trace::writeData(uint32_t data, uint_fast8_t bit_length)
+  {
+    fold_repeat(data, bit_length, 1);
+    _bus->writeData(data, bit_length);
+  }
+
+  void Bus_Trace::writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count)
+  {
+    fold_repeat(data, bit_length, count);
+    _bus->writeDataRepeat(data, bit_length, count);
+  }
+
+  void Bus_Trace::writePixels(pixelcopy_t* pc, uint32_t length)
+  {
+    uint32_t usec = micros();
+    auto copy = *pc;
+    _bus->writePixels(pc, length);
+
+    // 送信したものと同じ内容を変換して記録する;
+    flush_repeat();
+    if (!begin_record(op_pixels, usec)) { return; }
+    put_byte(copy.dst_bits);
+    put_varint(length);
+    uint8_t buf[256];
+    uint32_t chunk = (sizeof(buf) << 3) / (copy.dst_bits < 8 ? 8 : copy.dst_bits);
+    while (length && _tracing)
+    {
+      uint32_t len = length < chunk ? length : chunk;
+      copy.fp_copy(buf, 0, len, &copy);
+      put(buf, (copy.dst_bits * len + 7) >> 3);
+      length -= len;
+    }
+  }
+
+  void Bus_Trace::writeBytes(const uint8_t* data, uint32_t length, bool dc, bool use_dma)
+  {
+    record_bytes(op_bytes, data, length, (dc ? 1 : 0) | (use_dma ? 2 : 0));
+    _bus->writeBytes(data, length, dc, use_dma);
+  }
+
+  void Bus_Trace::beginRead(uint_fast8_t dummy_bits)
+  {
+    flush_repeat();
+    if (begin_record(op_read_begin, micros())) { put_byte(dummy_bits); }
+    _bus->beginRead(dummy_bits);
+  }
+
+  void Bus_Trace::beginRead(void)
+  {
+    flush_repeat();
+    if (begin_record(op_read_begin, micros())) { put_byte(0); }
+    _bus->beginRead();
+  }
+
+  void Bus_Trace::endRead(void)
+  {
+    record(op_read_end);
+    _bus->endRead();
+  }
+
+  uint32_t Bus_Trace::readData(uint_fast8_t bit_length)
+  {
+    record_read(bit_length >> 3);
+    return _bus->readData(bit_length);
+  }
+
+  bool Bus_Trace::readBytes(uint8_t* dst, uint32_t length, bool use_dma)
+  {
+    record_read(length);
+    return _bus->readBytes(dst, length, use_dma);
+  }
+
+  void Bus_Trace::readPixels(void* dst, pixelcopy_t* pc, uint32_t length)
+  {
+    record_read((pc->src_bits * length) >> 3);
+    _bus->readPixels(dst, pc, length);
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -0,0 +1,194 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include <stddef.h>
+
+#include "../Bus.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// バス通信の記録形式 (数値はリトルエンディアン、varint は LEB128);
+  /// header : "LGBT" , version(1) , bus_type(1);
+  /// record : op(1) , 前の記録からの経過時間usec(varint) , 以下 op 毎の内容;
+  namespace bus_trace
+  {
+    static constexpr uint8_t version = 1;
+
+    enum op_t : uint8_t
+    { op_none       = 0x00
+    , op_command    = 0x01  // bits(1) , value(bits/8)
+    , op_data       = 0x02  // bits(1) , value(bits/8)
+    , op_repeat     = 0x03  // bits(1) , value(bits/8) , count(varint)
+    , op_bytes      = 0x04  // flags(1) bit0:dc bit1:dma , length(varint) , bytes
+    , op_pixels     = 0x05  // bits(1) , count(varint) , 変換後のバイト列
+    , op_dma_queue  = 0x06  // length(varint) , bytes
+    , op_dma_exec   = 0x07
+    , op_begin      = 0x08  // beginTransaction
+    , op_end        = 0x09  // endTransaction
+    , op_wait       = 0x0A  // wait / flush
+    , op_read_begin = 0x0B  // dummy bits(1)
+    , op_read       = 0x0C  // length(varint) ( 読み出した量のみ記録する )
+    , op_read_end   = 0x0D
+    , op_clock      = 0x0E  // freq(varint)
+    , op_mark       = 0x0F  // id(varint) ( フレームの区切り等 )
+    , op_max
+    };
+  }
+
+  struct bus_trace_record_t
+  {
+    bus_trace::op_t op;
+    uint8_t bits;            // command / data / repeat / pixels / read_begin(dummy)
+    uint8_t flags;           // bytes : bit0 dc , bit1 dma
+    uint32_t usec;           // 記録開始からの経過時間
+    uint32_t delta_usec;     // 前の記録からの経過時間
+    uint32_t value;          // command / data / repeat の値 , clock , mark id
+    uint32_t count;          // repeat の回数 , pixels の画素数
+    uint32_t length;         // payload のバイト数 (read は読み出したバイト数)
+    const uint8_t* payload;
+  };
+
+  /// 記録済みのトレースを1件ずつ取り出す;
+  struct bus_trace_reader_t
+  {
+    bool begin(const uint8_t* data, uint32_t length);
+    bus_type_t busType(void) const { return _bus_type; }
+
+    /// 次の記録を取得する。終端または不正なデータの場合は false;
+    bool next(bus_trace_record_t* record);
+
+    /// 途中で不正なデータがあった場合は true;
+    bool hasError(void) const { return _error; }
+
+    /// 記録の内容をバスに再送する;
+    static void replay(const bus_trace_record_t& record, IBus* bus);
+
+  private:
+    const uint8_t* _data = nullptr;
+    uint32_t _length = 0;
+    uint32_t _pos = 0;
+    uint32_t _usec = 0;
+    bus_type_t _bus_type = bus_unknown;
+    bool _error = false;
+
+    bool read_varint(uint32_t* value);
+  };
+
+  /// 別のバスへの呼出しを中継し、通信内容を記録するバス。;
+  /// writeData / writeDataRepeat の同じ値の連続は1件の repeat にまとめる。;
+  /// 使い方: _trace.setBus(&_bus_instance); _panel_instance.setBus(&_trace); ... _trace.beginTrace(4096, output_cb);
+  class Bus_Trace : public IBus
+  {
+  public:
+    typedef void (*output_cb_t)(void* user_data, const uint8_t* data, uint32_t length);
+
+    Bus_Trace(void) { setBus(nullptr); }
+    Bus_Trace(IBus* bus) { setBus(bus); }
+    virtual ~Bus_Trace(void);
+
+    /// nullptr の場合は記録のみ行う;
+    void setBus(IBus* bus);
+    IBus* getBus(void) const { return _bus; }
+
+    /// 記録を開始する。output を指定した場合はバッファが一杯になる度に出力する。;
+    /// 省略した場合はバッファが一杯になった時点で記録を止める (isOverflow が true になる);
+    bool beginTrace(uint32_t buffer_length, output_cb_t output = nullptr, void* user_data = nullptr);
+
+    /// 記録を終える。output を指定した場合は残りを出力する (記録内容は getTrace で参照できる);
+    void endTrace(void);
+
+    /// バッファの内容を出力する;
+    void flushTrace(void);
+
+    /// 任意の印を記録する (フレームの区切り等);
+    void mark(uint32_t id);
+
+    const uint8_t* getTrace(void) const { return _buf; }
+    uint32_t getTraceLength(void) const { return _len; }
+    bool isTracing(void) const { return _tracing; }
+    bool isOverflow(void) const { return _overflow; }
+
+    bus_type_t busType(void) const override { return _bus->busType(); }
+    bool init(void) override { return _bus->init(); }
+    void release(void) override { _bus->release(); }
+    uint32_t getClock(void) const override { return _bus->getClock(); }
+    void setClock(uint32_t freq) override;
+
+    void beginTransaction(void) override;
+    void endTransaction(void) override;
+    void wait(void) override;
+    bool busy(void) const override { return _bus->busy(); }
+
+    void initDMA(void) override { _bus->initDMA(); }
+    void addDMAQueue(const uint8_t* data, uint32_t length) override;
+    void execDMAQueue(void) override;
+    uint8_t* getDMABuffer(uint32_t length) override { return _bus->getDMABuffer(length); }
+
+    void flush(void) override;
+    bool writeCommand(uint32_t data, uint_fast8_t bit_length) override;
+    void writeData(uint32_t data, uint_fast8_t bit_length) override;
+    void writeDataRepeat(uint32_t data, uint_fast8_t bit_length, uint32_t count) override;
+    void writePixels(pixelcopy_t* pc, uint32_t length) override;
+    void writeBytes(const uint8_t* data, uint32_t length, bool dc, bool use_dma) override;
+
+    void beginRead(uint_fast8_t dummy_bits) override;
+    void beginRead(void) override;
+    void endRead(void) override;
+    uint32_t readData(uint_fast8_t bit_length) override;
+    bool readBytes(uint8_t* dst, uint32_t length, bool use_dma) override;
+    void readPixels(void* dst, pixelcopy_t* pc, uint32_t length) override;
+
+  protected:
+    IBus* _bus = nullptr;
+    uint8_t* _buf = nullptr;
+    uint32_t _buf_len = 0;
+    uint32_t _len = 0;
+    uint32_t _rec_start = 0;
+    uint32_t _last_usec = 0;
+    output_cb_t _output = nullptr;
+    void* _user_data = nullptr;
+    bool _tracing = false;
+    bool _overflow = false;
+
+    // 同じ値の writeData / writeDataRepeat の連続をまとめる;
+    uint32_t _rep_value = 0;
+    uint32_t _rep_count = 0;
+    uint32_t _rep_usec = 0;
+    uint8_t _rep_bits = 0;
+
+    bool begin_record(bus_trace::op_t op, uint32_t usec);
+    void put(const void* data, uint32_t length);
+    void put_byte(uint8_t value) { put(&value, 1); }
+    void put_varint(uint32_t value);
+    void put_value(uint32_t value, uint_fast8_t bit_length);
+    void put_data(uint32_t data, uint_fast8_t bit_length);
+    void record(bus_trace::op_t op);
+    void record_bytes(bus_trace::op_t op, const uint8_t* data, uint32_t length, uint8_t flags);
+    void record_read(uint32_t length);
+    void fold_repeat(uint32_t data, uint_fast8_t bit_length, uint32_t count);
+    void flush_repeat(void);
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -3,6 +3,7 @@
 #include "platforms/common.hpp"
 #include "misc/pixelcopy.hpp"
 #include "LGFXBase.hpp"
+#include "LGFX_Sprite.hpp"
 
 #include "../Fonts/IPA/lgfx_font_japan.h"
 #include "../Fonts/efont/lgfx_efont_cn.h"
@@ -548,6 +549,165 @@ label_nextbyte: /// 次のデータを取得する;
   };
 
 
+  /// デコード済みのグリフ。runsは (0の長さ,1の長さ) の組を繰り返しを展開して並べたもの;
+  struct U8g2font::cache_entry_t
+  {
+    cache_entry_t* lru_prev;
+    cache_entry_t* lru_next;
+    cache_entry_t* hash_next;
+    const U8g2font* font;
+    uint32_t size;
+    uint16_t encoding;
+    uint16_t run_count;
+    uint8_t width;
+    uint8_t height;
+    int8_t x_offset;
+    int8_t y_offset;
+    int8_t x_advance;
+    uint8_t runs[1];
+  };
+
+  /// unicode部の文字コード順のインデックス;
+  struct U8g2font::index_t
+  {
+    index_t* next;
+    const U8g2font* font;
+    uint32_t count;
+    uint16_t* encodings;
+    uint32_t* offsets;
+  };
+
+  struct U8g2font::glyph_cache_t
+  {
+    static constexpr size_t hash_size = 64;
+
+    cache_entry_t* hash[hash_size] = {};
+    cache_entry_t* lru_head = nullptr;
+    cache_entry_t* lru_tail = nullptr;
+    index_t* index_list = nullptr;
+    size_t limit = 0;
+    size_t usage = 0;
+
+    static size_t hash_of(const U8g2font* font, uint16_t encoding)
+    {
+      return (encoding ^ ((uintptr_t)font >> 4)) & (hash_size - 1);
+    }
+
+    void unlink(cache_entry_t* e)
+    {
+      if (e->lru_prev) { e->lru_prev->lru_next = e->lru_next; } else { lru_head = e->lru_next; }
+      if (e->lru_next) { e->lru_next->lru_prev = e->lru_prev; } else { lru_tail = e->lru_prev; }
+    }
+
+    void push_front(cache_entry_t* e)
+    {
+      e->lru_prev = nullptr;
+      e->lru_next = lru_head;
+      if (lru_head) { lru_head->lru_prev = e; } else { lru_tail = e; }
+      lru_head = e;
+    }
+
+    void remove(cache_entry_t* e)
+    {
+      unlink(e);
+      auto p = &hash[hash_of(e->font, e->encoding)];
+      while (*p != e) { p = &(*p)->hash_next; }
+      *p = e->hash_next;
+      usage -= e->size;
+      heap_free(e);
+    }
+
+    cache_entry_t* find(const U8g2font* font, uint16_t encoding)
+    {
+      for (auto e = hash[hash_of(font, encoding)]; e; e = e->hash_next)
+      {
+        if (e->encoding == encoding && e->font == font)
+        {
+          if (e != lru_head) { unlink(e); push_front(e); }
+          return e;
+        }
+      }
+      return nullptr;
+    }
+
+    /// 古いものから解放して size バイトを確保できるようにする;
+    bool reserve(size_t size)
+    {
+      while (usage + size > limit)
+      {
+        if (lru_tail == nullptr) return false;
+        remove(lru_tail);
+      }
+      return true;
+    }
+
+    void release(void)
+    {
+      while (lru_tail) { remove(lru_tail); }
+      while (index_list)
+      {
+        auto idx = index_list;
+        index_list = idx->next;
+        usage -= sizeof(index_t) + idx->count * (sizeof(uint16_t) + sizeof(uint32_t));
+        heap_free(idx);
+      }
+    }
+
+    const index_t* get_index(const U8g2font* font)
+    {
+      if (limit == 0) return nullptr;
+      for (auto idx = index_list; idx; idx = idx->next)
+      {
+        if (idx->font == font) return idx->count ? idx : nullptr;
+      }
+
+      // unicode部のグリフは先頭のLUTの後ろに文字コード順に連続して並んでいる;
+      auto lut = &font->_font[23 + font->start_pos_unicode()];
+      auto top = lut + getSwap16(pgm_read_word(&lut[0]));
+      uint32_t count = 0;
+      for (auto p = top; getSwap16(pgm_read_word(&p[0])); p += pgm_read_byte(&p[2])) { ++count; }
+
+      size_t size = sizeof(index_t) + count * (sizeof(uint16_t) + sizeof(uint32_t));
+      if (!reserve(size)) { count = 0; size = sizeof(index_t); reserve(size); }
+      auto idx = (index_t*)heap_alloc(size);
+      if (idx == nullptr) return nullptr;
+      usage += size;
+      idx->next = index_list;
+      idx->font = font;
+      idx->count = count;
+      idx->offsets = reinterpret_cast<uint32_t*>(&idx[1]);
+      idx->encodings = reinterpret_cast<uint16_t*>(&idx->offsets[count]);
+      index_list = idx;
+      uint32_t i = 0;
+      for (auto p = top; i < count; p += pgm_read_byte(&p[2]), ++i)
+      {
+        idx->encodings[i] = getSwap16(pgm_read_word(&p[0]));
+        idx->offsets[i] = p - font->_font;
+      }
+      return count ? idx : nullptr;
+    }
+  };
+
+  U8g2font::glyph_cache_t U8g2font::_glyph_cache;
+
+  void U8g2font::setGlyphCache(size_t bytes)
+  {
+    _glyph_cache.limit = bytes;
+    if (bytes == 0)
+    {
+      _glyph_cache.release();
+    }
+    else
+    {
+      _glyph_cache.reserve(0);
+    }
+  }
+
+  size_t U8g2font::getGlyphCacheUsage(void)
+  {
+    return _glyph_cache.usage;
+  }
+
   const uint8_t* U8g2font::getGlyph(uint16_t encoding) const
   {
     const uint8_t *font = &this->_font[23];
@@ -562,6 +722,18 @@ label_nextbyte: /// 次のデータを取得する;
         if ( pgm_read_byte(&font[0]) == encoding ) { return font + 2; }  /* skip encoding and glyph size */
       }
     }
+    else if (auto idx = _glyph_cache.get_index(this))
+    {
+      uint32_t lo = 0;
+      uint32_t hi = idx->count;
+      while (lo < hi)
+      {
+        uint32_t mid = (lo + hi) >> 1;
+        if (idx->encodings[mid] < encoding) { lo = mid + 1; }
+        else { hi = mid; }
+      }
+      if (lo < idx->count && idx->encodings[lo] == encoding) { return &_font[idx->offsets[lo] + 3]; }
+    }
     else
     {
       uint_fast16_t e;
@@ -585,6 +757,118 @@ label_nextbyte: /// 次のデータを取得する;
     return nullptr;
   }
 
+  /// u8g2のランレングスを (0の長さ,1の長さ) の組として順に取り出す;
+  struct u8g2_run_decoder_t
+  {
+    u8g2_run_decoder_t(const u8g2_font_decode_t& decode, uint_fast8_t bits_per_0, uint_fast8_t bits_per_1)
+    : _decode(decode), _bits_per_0(bits_per_0), _bits_per_1(bits_per_1) {}
+
+    void next(uint32_t* ab)
+    {
+      if (!_repeat)
+      {
+        ab[0] = _decode.get_unsigned_bits(_bits_per_0);
+        ab[1] = _decode.get_unsigned_bits(_bits_per_1);
+      }
+      _repeat = _decode.get_unsigned_bits(1);
+    }
+
+  private:
+    u8g2_font_decode_t _decode;
+    uint_fast8_t _bits_per_0;
+    uint_fast8_t _bits_per_1;
+    bool _repeat = false;
+  };
+
+  struct u8g2_run_reader_t
+  {
+    u8g2_run_reader_t(const uint8_t* runs) : _runs(runs) {}
+
+    void next(uint32_t* ab)
+    {
+      ab[0] = _runs[0];
+      ab[1] = _runs[1];
+      _runs += 2;
+    }
+
+  private:
+    const uint8_t* _runs;
+  };
+
+  const U8g2font::cache_entry_t* U8g2font::getCachedGlyph(uint16_t encoding) const
+  {
+    if (_glyph_cache.limit == 0) return nullptr;
+    if (auto e = _glyph_cache.find(this, encoding)) return e;
+
+    u8g2_font_decode_t decode(getGlyph(encoding));
+    if (decode.decode_ptr == nullptr) return nullptr;
+
+    uint32_t w = decode.get_unsigned_bits(bits_per_char_width());
+    uint32_t h = decode.get_unsigned_bits(bits_per_char_height());
+    int32_t x_offset  = decode.get_signed_bits(bits_per_char_x());
+    int32_t y_offset  = decode.get_signed_bits(bits_per_char_y());
+    int32_t x_advance = decode.get_signed_bits(bits_per_delta_x());
+
+    // 1回目で組の数を数え、2回目で書き込む。255を超える長さは分割する;
+    uint32_t run_count = 0;
+    cache_entry_t* entry = nullptr;
+    for (int pass = 0; pass < 2; ++pass)
+    {
+      if (pass)
+      {
+        size_t size = sizeof(cache_entry_t) + run_count * 2;
+        if (!_glyph_cache.reserve(size)) return nullptr;
+        entry = (cache_entry_t*)heap_alloc(size);
+        if (entry == nullptr) return nullptr;
+        _glyph_cache.usage += size;
+        entry->size = size;
+        entry->font = this;
+        entry->encoding = encoding;
+        entry->run_count = run_count;
+        entry->width = w;
+        entry->height = h;
+        entry->x_offset = x_offset;
+        entry->y_offset = y_offset;
+        entry->x_advance = x_advance;
+        run_count = 0;
+      }
+      if (w == 0) continue;
+      u8g2_run_decoder_t runs(decode, bits_per_0(), bits_per_1());
+      int32_t remain = w * h;
+      uint32_t ab[2] = { 0, 0 };
+      do
+      {
+        runs.next(ab);
+        while (ab[0] > 255)
+        {
+          if (entry) { entry->runs[run_count * 2] = 255; entry->runs[run_count * 2 + 1] = 0; }
+          ++run_count;
+          ab[0] -= 255;
+          remain -= 255;
+        }
+        uint32_t a = ab[0];
+        uint32_t b = ab[1];
+        while (b > 255)
+        {
+          if (entry) { entry->runs[run_count * 2] = a; entry->runs[run_count * 2 + 1] = 255; }
+          ++run_count;
+          remain -= a + 255;
+          a = 0;
+          b -= 255;
+        }
+        if (entry) { entry->runs[run_count * 2] = a; entry->runs[run_count * 2 + 1] = b; }
+        ++run_count;
+        remain -= a + b;
+      } while (remain > 0);
+    }
+
+    auto& head = _glyph_cache.hash[glyph_cache_t::hash_of(this, encoding)];
+    entry->hash_next = head;
+    head = entry;
+    _glyph_cache.push_front(entry);
+    return entry;
+  }
+
   void U8g2font::getDefaultMetric(lgfx::FontMetrics *metrics) const
   {
     metrics->height    = max_char_height();
@@ -596,6 +880,13 @@ label_nextbyte: /// 次のデータを取得する;
 
   bool U8g2font::updateFontMetric(lgfx::FontMetrics *metrics, uint16_t uniCode) const
   {
+    if (auto entry = getCachedGlyph(uniCode))
+    {
+      metrics->width     = entry->width;
+      metrics->x_offset  = entry->x_offset;
+      metrics->x_advance = entry->x_advance;
+      return true;
+    }
     u8g2_font_decode_t decode(getGlyph(uniCode));
     if ( decode.decode_ptr )
     {
@@ -611,23 +902,85 @@ label_nextbyte: /// 次のデータを取得する;
     return false;
   }
 
+  template <typename TRuns>
+  static void u8g2_draw_runs(LGFXBase* gfx, TRuns& runs, int32_t x, int32_t y, int32_t left, uint32_t w, uint32_t h, int32_t yoffset, int32_t sx, int32_t sy, bool fillbg, const uint32_t* colortbl)
+  {
+    uint32_t ab[2] = { 0, 0 };
+    uint32_t lx = 0;
+    uint32_t ly = 0;
+    int32_t y0 = ((yoffset    ) * sy) >> 16;
+    int32_t y1 = ((yoffset + 1) * sy) >> 16;
+    do
+    {
+      runs.next(ab);
+      for (uint_fast8_t i = 0; i < 2; ++i)
+      {
+        uint32_t length = ab[i];
+        while (length)
+        {
+          uint32_t len = (length > w - lx) ? w - lx : length;
+          length -= len;
+          if (i || fillbg)
+          {
+            int32_t x0 = (lx * sx) >> 16;
+            if (!i && x0 < left) x0 = left;
+            int32_t x1 = ((lx + len) * sx) >> 16;
+            if (x0 < x1)
+            {
+              gfx->setRawColor(colortbl[i]);
+              gfx->writeFillRect( x + x0
+                                , y + y0
+                                , x1 - x0
+                                , y1 - y0);
+            }
+          }
+          lx += len;
+          if (lx == w)
+          {
+            lx = 0;
+            ++ly;
+            y0 = y1;
+            y1 = ((ly + yoffset + 1) * sy) >> 16;
+          }
+        }
+      }
+    } while (ly < h);
+  }
+
   size_t U8g2font::drawChar(LGFXBase* gfx, int32_t x, int32_t y, uint16_t uniCode, const TextStyle* style, FontMetrics* metrics, int32_t& filled_x) const
   {
     int32_t sy = 65536 * style->size_y;
     y += (metrics->y_offset * sy) >> 16;
-    u8g2_font_decode_t decode(getGlyph(uniCode));
-    if ( decode.decode_ptr == nullptr ) return drawCharDummy(gfx, x, y, this->max_char_width(), metrics->height, style, filled_x);
 
-    uint32_t w = decode.get_unsigned_bits(bits_per_char_width());
-    uint32_t h = decode.get_unsigned_bits(bits_per_char_height());
+    uint32_t w, h;
+    int32_t glyph_x, glyph_y, glyph_advance;
+    auto entry = getCachedGlyph(uniCode);
+    u8g2_font_decode_t decode(entry ? nullptr : getGlyph(uniCode));
+    if (entry)
+    {
+      w = entry->width;
+      h = entry->height;
+      glyph_x = entry->x_offset;
+      glyph_y = entry->y_offset;
+      glyph_advance = entry->x_advance;
+    }
+    else
+    {
+      if ( decode.decode_ptr == nullptr ) return drawCharDummy(gfx, x, y, this->max_char_width(), metrics->height, style, filled_x);
+      w = decode.get_unsigned_bits(bits_per_char_width());
+      h = decode.get_unsigned_bits(bits_per_char_height());
+      glyph_x = decode.get_signed_bits(bits_per_char_x());
+      glyph_y = decode.get_signed_bits(bits_per_char_y());
+      glyph_advance = decode.get_signed_bits(bits_per_delta_x());
+    }
 
     int32_t sx = 65536 * style->size_x;
 
-    int32_t xoffset = (decode.get_signed_bits(bits_per_char_x()) * sx) >> 16;
+    int32_t xoffset = (glyph_x * sx) >> 16;
 
-    int32_t yoffset = -(int32_t)(decode.get_signed_bits(bits_per_char_y()) + h + metrics->y_offset);
+    int32_t yoffset = -(int32_t)(glyph_y + h + metrics->y_offset);
 
-    int32_t xAdvance = (decode.get_signed_bits(bits_per_delta_x()) * sx) >> 16;
+    int32_t xAdvance = (glyph_advance * sx) >> 16;
 
     uint32_t colortbl[2] = {gfx->getColorConverter()->convert(style->back_rgb888), gfx->getColorConverter()->convert(style->fore_rgb888)};
     bool fillbg = (style->back_rgb888 != style->fore_rgb888);
@@ -671,52 +1024,377 @@ label_nextbyte: /// 次のデータを取得する;
         }
       }
       left -= x;
-      uint32_t ab[2];
-      uint32_t lx = 0;
-      uint32_t ly = 0;
-      int32_t y0 = ((yoffset    ) * sy) >> 16;
-      int32_t y1 = ((yoffset + 1) * sy) >> 16;
-      do
+      if (entry)
       {
-        ab[0] = decode.get_unsigned_bits(bits_per_0());
-        ab[1] = decode.get_unsigned_bits(bits_per_1());
-        bool i = 0;
-        do
+        u8g2_run_reader_t runs(entry->runs);
+        u8g2_draw_runs(gfx, runs, x, y, left, w, h, yoffset, sx, sy, fillbg, colortbl);
+      }
+      else
+      {
+        u8g2_run_decoder_t runs(decode, bits_per_0(), bits_per_1());
+        u8g2_draw_runs(gfx, runs, x, y, left, w, h, yoffset, sx, sy, fillbg, colortbl);
+      }
+    }
+    gfx->endWrite();
+    return xAdvance;
+  }
+
+//----------------------------------------------------------------------------
+
+  static constexpr size_t atlas_table_offset = sizeof(AtlasFont::header_t);
+  static constexpr size_t atlas_page_offset = atlas_table_offset + 256 * sizeof(uint16_t);
+
+  bool AtlasFont::isValid(void) const
+  {
+    return _data != nullptr
+        && pgm_read_byte(&_data[0]) == 'L'
+        && pgm_read_byte(&_data[1]) == 'G'
+        && pgm_read_byte(&_data[2]) == 'A'
+        && pgm_read_byte(&_data[3]) == '1';
+  }
+
+  bool AtlasFont::validate(const uint8_t* data, size_t length)
+  {
+    if (data == nullptr || length < atlas_page_offset || !AtlasFont(data).isValid()) return false;
+    auto header = reinterpret_cast<const header_t*>(data);
+    uint32_t page_count  = pgm_read_word(&header->page_count);
+    uint32_t glyph_count = pgm_read_word(&header->glyph_count);
+    uint32_t span_count  = pgm_read_dword(&header->span_count);
+    if (page_count > 256 || glyph_count >= NO_ENTRY) return false;
+    size_t glyph_offset = atlas_page_offset + page_count * 256 * sizeof(uint16_t);
+    size_t span_offset = glyph_offset + glyph_count * sizeof(glyph_t);
+    if (length < span_offset || (length - span_offset) / sizeof(span_t) < span_count) return false;
+
+    // 各テーブルの参照先が範囲内であることを確認する;
+    auto table = reinterpret_cast<const uint16_t*>(&data[atlas_table_offset]);
+    for (size_t i = 0; i < 256; ++i)
+    {
+      uint32_t page = pgm_read_word(&table[i]);
+      if (page != NO_ENTRY && page >= page_count) return false;
+    }
+    auto pages = reinterpret_cast<const uint16_t*>(&data[atlas_page_offset]);
+    for (size_t i = 0; i < page_count * 256; ++i)
+    {
+      uint32_t index = pgm_read_word(&pages[i]);
+      if (index != NO_ENTRY && index >= glyph_count) return false;
+    }
+    auto glyphs = reinterpret_cast<const glyph_t*>(&data[glyph_offset]);
+    for (size_t i = 0; i < glyph_count; ++i)
+    {
+      uint32_t first = pgm_read_dword(&glyphs[i].span_index);
+      if (first > span_count || span_count - first < pgm_read_word(&glyphs[i].span_count)) return false;
+    }
+    return true;
+  }
+
+  uint16_t AtlasFont::getSpaceWidth(void) const
+  {
+    return isValid() ? pgm_read_word(&reinterpret_cast<const header_t*>(_data)->space_width) : 0;
+  }
+
+  const AtlasFont::glyph_t* AtlasFont::getGlyph(uint16_t uniCode) const
+  {
+    if (!isValid()) return nullptr;
+    auto table = reinterpret_cast<const uint16_t*>(&_data[atlas_table_offset]);
+    uint_fast16_t page = pgm_read_word(&table[uniCode >> 8]);
+    if (page == NO_ENTRY) return nullptr;
+    auto pages = reinterpret_cast<const uint16_t*>(&_data[atlas_page_offset]);
+    uint_fast16_t index = pgm_read_word(&pages[(page << 8) + (uniCode & 0xFF)]);
+    if (index == NO_ENTRY) return nullptr;
+    auto header = reinterpret_cast<const header_t*>(_data);
+    auto glyphs = reinterpret_cast<const glyph_t*>(&_data[atlas_page_offset + pgm_read_word(&header->page_count) * 256 * sizeof(uint16_t)]);
+    return &glyphs[index];
+  }
+
+  void AtlasFont::getDefaultMetric(FontMetrics *metrics) const
+  {
+    if (!isValid())
+    {
+      memset(metrics, 0, sizeof(FontMetrics));
+      return;
+    }
+    auto header = reinterpret_cast<const header_t*>(_data);
+    metrics->width     = pgm_read_word(&header->space_width);
+    metrics->x_advance = metrics->width;
+    metrics->x_offset  = 0;
+    metrics->height    = (int16_t)pgm_read_word(&header->height);
+    metrics->baseline  = (int16_t)pgm_read_word(&header->baseline);
+    metrics->y_offset  = - metrics->baseline;
+    metrics->y_advance = (int16_t)pgm_read_word(&header->y_advance);
+  }
+
+  bool AtlasFont::updateFontMetric(FontMetrics *metrics, uint16_t uniCode) const
+  {
+    auto glyph = getGlyph(uniCode);
+    if (!glyph)
+    {
+      metrics->x_offset = 0;
+      metrics->width = metrics->x_advance = getSpaceWidth();
+      return false;
+    }
+    metrics->x_offset  = (int8_t)pgm_read_byte(&glyph->x_offset);
+    metrics->width     = pgm_read_byte(&glyph->width);
+    metrics->x_advance = pgm_read_byte(&glyph->x_advance);
+    return true;
+  }
+
+  size_t AtlasFont::drawChar(LGFXBase* gfx, int32_t x, int32_t y, uint16_t uniCode, const TextStyle* style, FontMetrics* metrics, int32_t& filled_x) const
+  {
+    int32_t sy = 65536 * style->size_y;
+    y += (metrics->y_offset * sy) >> 16;
+    auto glyph = getGlyph(uniCode);
+    if (!glyph)
+    {
+      return drawCharDummy(gfx, x, y, getSpaceWidth(), metrics->height, style, filled_x);
+    }
+
+    int32_t w       = pgm_read_byte(&glyph->width);
+    int32_t h       = pgm_read_byte(&glyph->height);
+    int32_t xoffset = (int8_t)pgm_read_byte(&glyph->x_offset);
+    int32_t yoffset = (int8_t)pgm_read_byte(&glyph->y_offset);
+    int32_t sx = 65536 * style->size_x;
+    int32_t xAdvance = (sx * pgm_read_byte(&glyph->x_advance)) >> 16;
+
+    uint32_t colortbl[2] = {gfx->getColorConverter()->convert(style->back_rgb888), gfx->getColorConverter()->convert(style->fore_rgb888)};
+    bool fillbg = (style->back_rgb888 != style->fore_rgb888);
+    int32_t left  = 0;
+    int32_t right = 0;
+    if (fillbg) {
+      left  = std::max<int>(filled_x, x + (xoffset < 0 ? ((xoffset * sx) >> 16) : 0));
+      right = x + std::max<int>(((xoffset + w) * sx) >> 16, xAdvance);
+      filled_x = right;
+    }
+
+    gfx->startWrite();
+
+    if (left < right) {
+      gfx->setRawColor(colortbl[0]);
+      if (yoffset > 0) {
+        gfx->writeFillRect(left, y, right - left, (yoffset * sy) >> 16);
+      }
+      int32_t y0 = ((yoffset + h)   * sy) >> 16;
+      int32_t y1 = (metrics->height * sy) >> 16;
+      if (y0 < y1) {
+        gfx->writeFillRect(left, y + y0, right - left, y1 - y0);
+      }
+    }
+
+    uint32_t back = fillbg ? style->back_rgb888 : gfx->getBaseColor();
+    int32_t fore_r = (style->fore_rgb888 >> 16) & 0xFF;
+    int32_t fore_g = (style->fore_rgb888 >>  8) & 0xFF;
+    int32_t fore_b = (style->fore_rgb888      ) & 0xFF;
+    int32_t back_r = (back >> 16) & 0xFF;
+    int32_t back_g = (back >>  8) & 0xFF;
+    int32_t back_b = (back      ) & 0xFF;
+
+    auto header = reinterpret_cast<const header_t*>(_data);
+    auto spans = reinterpret_cast<const span_t*>(&_data[atlas_page_offset
+                                                       + pgm_read_word(&header->page_count) * 256 * sizeof(uint16_t)
+                                                       + pgm_read_word(&header->glyph_count) * sizeof(glyph_t)]);
+    auto span = &spans[pgm_read_dword(&glyph->span_index)];
+    auto span_end = &span[pgm_read_word(&glyph->span_count)];
+
+    uint_fast8_t current = 2;
+    int32_t y1 = (yoffset * sy) >> 16;
+    for (int32_t row = 0; row < h; ++row)
+    {
+      int32_t y0 = y1;
+      y1 = ((yoffset + row + 1) * sy) >> 16;
+      int32_t fh = y1 - y0;
+      int32_t cursor = left;
+      for (; span != span_end && pgm_read_byte(&span->y) == row; ++span)
+      {
+        if (fh <= 0) continue;
+        int32_t sxp = xoffset + pgm_read_byte(&span->x);
+        int32_t x0 = x + ((sxp * sx) >> 16);
+        int32_t x1 = x + (((sxp + pgm_read_byte(&span->length)) * sx) >> 16);
+        if (x0 >= x1) continue;
+        if (fillbg && cursor < x0)
+        {
+          if (current != 0) { gfx->setRawColor(colortbl[0]); current = 0; }
+          gfx->writeFillRect(cursor, y + y0, x0 - cursor, fh);
+        }
+        uint_fast8_t alpha = pgm_read_byte(&span->alpha);
+        if (alpha == 255)
+        {
+          if (current != 1) { gfx->setRawColor(colortbl[1]); current = 1; }
+        }
+        else
+        {
+          int32_t p = 1 + alpha;
+          gfx->setColor(color888( (fore_r * p + back_r * (257 - p)) >> 8
+                                , (fore_g * p + back_g * (257 - p)) >> 8
+                                , (fore_b * p + back_b * (257 - p)) >> 8 ));
+          current = 2;
+        }
+        gfx->writeFillRect(x0, y + y0, x1 - x0, fh);
+        cursor = x1;
+      }
+      if (fh > 0 && cursor < right)
+      {
+        if (current != 0) { gfx->setRawColor(colortbl[0]); current = 0; }
+        gfx->writeFillRect(cursor, y + y0, right - cursor, fh);
+      }
+    }
+
+    gfx->endWrite();
+    return xAdvance;
+  }
+
+  uint8_t* AtlasFont::build(const IFont* src, const uint16_t* codes, size_t count, size_t* length)
+  {
+    if (length) { *length = 0; }
+    if (src == nullptr || codes == nullptr || count == 0) return nullptr;
+
+    FontMetrics metrics;
+    src->getDefaultMetric(&metrics);
+    int32_t line_height = metrics.height;
+    if (line_height <= 0) return nullptr;
+
+    // 各文字を24bitのスプライトに白黒で描画し、輝度を被覆率として行毎のspanに分解する;
+    // 1回目で数を数え、2回目で書き込む;
+    TextStyle style;
+    style.fore_rgb888 = 0xFFFFFFu;
+    style.back_rgb888 = 0;
+    LGFX_Sprite canvas;
+    canvas.setColorDepth(24);
+    int32_t canvas_w = 0;
+
+    uint16_t table[256];
+    uint32_t page_count = 0;
+    uint32_t glyph_count = 0;
+    uint32_t span_count = 0;
+    uint8_t* data = nullptr;
+    auto used = (uint32_t*)heap_alloc(65536 / 8);  // 重複した文字コードを除くためのフラグ;
+    if (used == nullptr) return nullptr;
+    glyph_t* glyphs = nullptr;
+    span_t* spans = nullptr;
+    uint16_t* pages = nullptr;
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+      if (pass)
+      {
+        size_t len = atlas_page_offset
+                   + page_count  * 256 * sizeof(uint16_t)
+                   + glyph_count * sizeof(glyph_t)
+                   + span_count  * sizeof(span_t);
+        data = (uint8_t*)heap_alloc_psram(len);
+        if (data == nullptr) { data = (uint8_t*)heap_alloc(len); }
+        if (data == nullptr) { heap_free(used); return nullptr; }
+        memset(data, 0, len);
+        auto header = reinterpret_cast<header_t*>(data);
+        memcpy(header->magic, "LGA1", 4);
+        header->glyph_count = glyph_count;
+        header->page_count  = page_count;
+        header->height      = line_height;
+        header->baseline    = metrics.baseline;
+        header->y_advance   = metrics.y_advance;
+        FontMetrics space = metrics;
+        src->updateFontMetric(&space, 0x20);
+        header->space_width = space.x_advance;
+        header->span_count  = span_count;
+        memcpy(&data[atlas_table_offset], table, sizeof(table));
+        pages  = reinterpret_cast<uint16_t*>(&data[atlas_page_offset]);
+        glyphs = reinterpret_cast<glyph_t*>(&pages[page_count * 256]);
+        spans  = reinterpret_cast<span_t*>(&glyphs[glyph_count]);
+        memset(pages, 0xFF, page_count * 256 * sizeof(uint16_t));
+      }
+      memset(table, 0xFF, sizeof(table));
+      memset(used, 0, 65536 / 8);
+      page_count = 0;
+      glyph_count = 0;
+      span_count = 0;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        uint16_t code = codes[i];
+        if (code < 0x20) continue;
+        if (used[code >> 5] & (1u << (code & 31))) continue;
+        used[code >> 5] |= 1u << (code & 31);
+
+        FontMetrics m = metrics;
+        if (!src->updateFontMetric(&m, code)) continue;
+        if (m.x_advance < 0 || m.x_advance > 255) continue;
+
+        int32_t x0 = std::max<int32_t>(0, - m.x_offset) + 1;
+        int32_t w = x0 + std::max<int32_t>(m.x_advance, m.x_offset + m.width) + 1;
+        if (canvas_w < w)
+        {
+          canvas.deleteSprite();
+          if (!canvas.createSprite(w, line_height))
+          {
+            heap_free(used);
+            if (data) { heap_free(data); }
+            return nullptr;
+          }
+          canvas_w = w;
+        }
+        canvas.fillScreen(0);
+        int32_t filled_x = 0;
+        src->drawChar(&canvas, x0, - m.y_offset, code, &style, &m, filled_x);
+
+        // 描画された範囲を求める;
+        int32_t gl = INT32_MAX, gr = -1, gt = INT32_MAX, gb = -1;
+        for (int32_t py = 0; py < line_height; ++py)
         {
-          uint32_t length = ab[i];
-          while (length)
+          for (int32_t px = 0; px < canvas_w; ++px)
           {
-            uint32_t len = (length > w - lx) ? w - lx : length;
-            length -= len;
-            if (i || fillbg)
+            if (canvas.readPixelValue(px, py) & 0xFF00)
             {
-              int32_t x0 = (lx * sx) >> 16;
-              if (!i && x0 < left) x0 = left;
-              int32_t x1 = ((lx + len) * sx) >> 16;
-              if (x0 < x1)
-              {
-                gfx->setRawColor(colortbl[i]);
-                gfx->writeFillRect( x + x0
-                                  , y + y0
-                                  , x1 - x0
-                                  , y1 - y0);
-              }
+              gl = std::min(gl, px); gr = std::max(gr, px);
+              gt = std::min(gt, py); gb = std::max(gb, py);
             }
-            lx += len;
-            if (lx == w)
+          }
+        }
+        if (gr < 0) { gl = x0; gr = x0 - 1; gt = 0; gb = -1; }
+
+        // glyph_t / span_t の各項目に収まらないグリフは除外する (幅・高さ255以下であれば1文字のspan数も16bitに収まる);
+        if (gr - gl >= 255 || gb - gt >= 255 || gl - x0 < INT8_MIN || gl - x0 > INT8_MAX || gt > INT8_MAX) continue;
+
+        uint_fast8_t hi = code >> 8;
+        if (table[hi] == NO_ENTRY) { table[hi] = page_count++; }
+
+        uint32_t first_span = span_count;
+        for (int32_t py = gt; py <= gb; ++py)
+        {
+          int32_t px = gl;
+          while (px <= gr)
+          {
+            uint_fast8_t a = ((canvas.readPixelValue(px, py) >> 8) & 0xFF) >> 4;
+            if (a == 0) { ++px; continue; }
+            int32_t start = px;
+            while (++px <= gr && px - start < 255 && (((canvas.readPixelValue(px, py) >> 8) & 0xFF) >> 4) == a);
+            if (spans)
             {
-              lx = 0;
-              ++ly;
-              y0 = y1;
-              y1 = ((ly + yoffset + 1) * sy) >> 16;
+              auto &sp = spans[span_count];
+              sp.x = start - gl;
+              sp.y = py - gt;
+              sp.length = px - start;
+              sp.alpha = a * 17;
             }
+            ++span_count;
           }
-          i = !i;
-        } while (i || decode.get_unsigned_bits(1) != 0 );
-      } while (ly < h);
+        }
+        if (pages)
+        {
+          pages[(table[hi] << 8) + (code & 0xFF)] = glyph_count;
+          auto &g = glyphs[glyph_count];
+          g.span_index = first_span;
+          g.span_count = span_count - first_span;
+          g.width      = gr - gl + 1;
+          g.height     = gb - gt + 1;
+          g.x_offset   = gl - x0;
+          g.y_offset   = gt;
+          g.x_advance  = m.x_advance;
+        }
+        ++glyph_count;
+      }
     }
-    gfx->endWrite();
-    return xAdvance;
+    canvas.deleteSprite();
+    heap_free(used);
+    if (length) { *length = atlas_page_offset + page_count * 256 * sizeof(uint16_t) + glyph_count * sizeof(glyph_t) + span_count * sizeof(span_t); }
+    return data;
   }
 
 //----------------------------------------------------------------------------
@@ -28,6 +28,7 @@ namespace lgfx
     , ft_vlw
     , ft_u8g2
     , ft_ttf
+    , ft_atlas
     };
 
     virtual font_type_t getType(void) const { return font_type_t::ft_unknown; }
@@ -200,11 +201,88 @@ namespace lgfx
     bool updateFontMetric(FontMetrics *metrics, uint16_t uniCode) const override;
     size_t drawChar(LGFXBase* gfx, int32_t x, int32_t y, uint16_t c, const TextStyle* style, FontMetrics* metrics, int32_t& filled_x) const override;
 
+    /// デコード済みグリフのキャッシュに使用する最大バイト数を設定する (全てのU8g2fontで共有、0で無効);
+    /// 有効な間はunicode部の検索用インデックスも初回使用時にフォント毎に作成する;
+    /// ※ キャッシュは排他制御を行わない。U8g2fontで描画するタスクが1つだけの場合に限り有効にすること;
+    static void setGlyphCache(size_t bytes);
+    static size_t getGlyphCacheUsage(void);
+
   private:
+    struct cache_entry_t;
+    struct index_t;
+    struct glyph_cache_t;
+    static glyph_cache_t _glyph_cache;  // 単一タスクからの使用を前提とする (setGlyphCache参照);
     const uint8_t* getGlyph(uint16_t encoding) const;
+    const cache_entry_t* getCachedGlyph(uint16_t encoding) const;
     const uint8_t* _font;
   };
 
+//----------------------------------------------------------------------------
+// atlas font
+
+  /// 他のフォントから AtlasFont::build で生成した、展開済みのグリフを保持するフォント。;
+  /// 文字コードは2段の直接参照テーブルで引き、グリフは行毎の塗り潰し範囲 (span) として描画する。;
+  struct AtlasFont : public lgfx::IFont
+  {
+    struct header_t
+    {
+      uint8_t  magic[4];     // "LGA1"
+      uint16_t glyph_count;
+      uint16_t page_count;   // 下位テーブル (256要素) の数;
+      int16_t  height;
+      int16_t  baseline;
+      int16_t  y_advance;
+      uint16_t space_width;
+      uint32_t span_count;
+    };
+
+    struct glyph_t
+    {
+      uint32_t span_index;
+      uint16_t span_count;
+      uint8_t  width;
+      uint8_t  height;
+      int8_t   x_offset;     // カーソル位置からの距離;
+      int8_t   y_offset;     // 行の上端からの距離;
+      uint8_t  x_advance;
+      uint8_t  reserved;
+    };
+
+    struct span_t
+    {
+      uint8_t x;             // グリフの左上からの位置;
+      uint8_t y;
+      uint8_t length;
+      uint8_t alpha;         // 255 = 前景色;
+    };
+
+    static constexpr uint16_t NO_ENTRY = 0xFFFF;
+
+    // data layout : header_t, uint16_t table[256], uint16_t pages[page_count][256], glyph_t[glyph_count], span_t[span_count]
+    constexpr AtlasFont(const uint8_t *atlas_data) : _data(atlas_data) {}
+    font_type_t getType(void) const override { return ft_atlas; }
+
+    void getDefaultMetric(FontMetrics *metrics) const override;
+    bool updateFontMetric(FontMetrics *metrics, uint16_t uniCode) const override;
+    size_t drawChar(LGFXBase* gfx, int32_t x, int32_t y, uint16_t c, const TextStyle* style, FontMetrics* metrics, int32_t& filled_x) const override;
+
+    /// src の codes に含まれる文字を描画してアトラスを生成する。戻り値はheap_allocで確保したデータ (不要になったらheap_freeすること);
+    /// ( PCで実行して保存したデータをAtlasFontとしてそのまま使用できる );
+    /// 大きさ等が glyph_t の各項目に収まらない文字 (幅・高さ256以上等) は含めない;
+    static uint8_t* build(const IFont* src, const uint16_t* codes, size_t count, size_t* length);
+
+    /// 先頭の識別子 ("LGA1") が一致するか。一致しない場合は全ての文字を未定義として扱う;
+    bool isValid(void) const;
+
+    /// ファイル等から読込んだデータを使用する前に、識別子と各テーブルの参照先が length の範囲内であることを確認する;
+    static bool validate(const uint8_t* data, size_t length);
+
+  private:
+    uint16_t getSpaceWidth(void) const;
+    const glyph_t* getGlyph(uint16_t uniCode) const;
+    const uint8_t* _data;
+  };
+
 //----------------------------------------------------------------------------
 
   struct RunTimeFont : public IFont
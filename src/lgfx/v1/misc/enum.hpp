@@ -51,6 +51,32 @@ namespace lgfx
   }
   using namespace epd_mode;
 
+//----------------------------------------------------------------------------
+
+  namespace dither_mode
+  {
+    /// 組織的ディザの行列は描画先の座標で引く。1/2/4bit のパレットはグレースケール(setPaletteGrayscale()の状態)の場合のみ対象;
+    enum dither_mode_t
+    {
+      dither_none      = 0,
+      dither_ordered   = 1, // 8x8 Bayer
+      dither_diffusion = 2, // Floyd-Steinberg (serpentine)
+    };
+  }
+  using namespace dither_mode;
+
+//----------------------------------------------------------------------------
+
+  namespace interlace_mode
+  {
+    enum interlace_mode_t
+    {
+      interlace_final       = 0, // Adam7 passes are accumulated, completed rows are pushed
+      interlace_progressive = 1, // each pass is shown at once, expanded to blocks
+    };
+  }
+  using namespace interlace_mode;
+
 //----------------------------------------------------------------------------
 
   namespace colors  // Colour enumeration
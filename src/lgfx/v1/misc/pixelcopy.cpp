@@ -254,6 +254,93 @@ namespace lgfx
       return index;
     }
 
+    const uint8_t pixelcopy_t::dither_bayer8x8[64] =
+    {   2, 130,  34, 162,  10, 138,  42, 170
+    , 194,  66, 226,  98, 202,  74, 234, 106
+    ,  50, 178,  18, 146,  58, 186,  26, 154
+    , 242, 114, 210,  82, 250, 122, 218,  90
+    ,  14, 142,  46, 174,   6, 134,  38, 166
+    , 206,  78, 238, 110, 198,  70, 230, 102
+    ,  62, 190,  30, 158,  54, 182,  22, 150
+    , 254, 126, 222,  94, 246, 118, 214,  86
+    };
+
+    bool pixelcopy_t::set_dither(bool dst_pos)
+    {
+      if (palette || no_dither) return false;
+      decltype(fp_copy) fp = nullptr;
+      switch (src_depth)
+      {
+      case rgb565_2Byte:   fp = get_fp_copy_rgb_dither<swap565_t >(dst_depth, dst_pos); fp_skip = skip_rgb_affine<swap565_t >; break;
+      case rgb332_1Byte:   fp = get_fp_copy_rgb_dither<rgb332_t  >(dst_depth, dst_pos); fp_skip = skip_rgb_affine<rgb332_t  >; break;
+      case rgb888_3Byte:   fp = get_fp_copy_rgb_dither<bgr888_t  >(dst_depth, dst_pos); fp_skip = skip_rgb_affine<bgr888_t  >; break;
+      case rgb666_3Byte:   fp = get_fp_copy_rgb_dither<bgr666_t  >(dst_depth, dst_pos); fp_skip = skip_rgb_affine<bgr666_t  >; break;
+      case argb8888_4Byte: fp = get_fp_copy_rgb_dither<bgra8888_t>(dst_depth, dst_pos); fp_skip = skip_rgb_affine<bgra8888_t>; break;
+      default: break;
+      }
+      if (fp == nullptr) return false;
+      fp_copy = fp;
+      no_convert = false;
+      return true;
+    }
+
+    void pixelcopy_t::diffuse_row(void* __restrict dst, const bgr888_t* __restrict src, uint32_t len, int16_t* __restrict err, color_depth_t dst_depth, bool reverse)
+    {
+      uint_fast8_t dst_bits = dst_depth & color_depth_t::bit_mask;
+      uint_fast8_t ch = (dst_bits < 8) ? 1 : 3;
+      int32_t max[3];
+      if (dst_bits < 8) { max[0] = (1 << dst_bits) - 1; }
+      else if (dst_bits == 8) { max[0] = 7; max[1] = 7; max[2] = 3; }
+      else { max[0] = 31; max[1] = 63; max[2] = 31; }
+      int32_t mul[3];
+      for (size_t c = 0; c < ch; ++c) { mul[c] = (255 << 8) / max[c]; }
+
+      // 誤差は 1/16 単位で保持する。err[x] は上の行から x へ拡散された分。;
+      int32_t right[3] = { 0, 0, 0 };  // 左(右)隣から x へ : 7/16
+      int32_t acc0[3]  = { 0, 0, 0 };  // 次行の x-1 へ : 5/16 + 1/16 (3/16 は x で加える)
+      int32_t acc1[3]  = { 0, 0, 0 };  // 次行の x   へ : 1/16 (5/16 は x+1 で加える)
+      int32_t step = reverse ? -3 : 3;
+      int32_t x = reverse ? len - 1 : 0;
+      auto e = &err[(x + 1) * 3];
+      auto d8 = static_cast<uint8_t*>(dst);
+      auto d16 = static_cast<uint16_t*>(dst);
+      for (uint32_t i = 0; i < len; ++i)
+      {
+        int32_t v[3] = { src[x].r, src[x].g, src[x].b };
+        if (ch == 1) { v[0] = (v[0] + (v[1] << 1) + v[2]) >> 2; }
+        int32_t q[3];
+        for (size_t c = 0; c < ch; ++c)
+        {
+          int32_t val = v[c] + ((e[c] + right[c] + 8) >> 4);
+          val = (val < 0) ? 0 : (val > 255) ? 255 : val;
+          q[c] = (val * max[c] + 128) >> 8;
+          int32_t diff = val - ((q[c] * mul[c] + 128) >> 8);
+          right[c] = diff * 7;
+          e[c - step] = acc0[c] + diff * 3;
+          acc0[c] = acc1[c] + diff * 5;
+          acc1[c] = diff;
+        }
+        if (dst_bits == 16)
+        {
+          d16[x] = getSwap16((q[0] << 11) | (q[1] << 5) | q[2]);
+        }
+        else if (dst_bits == 8)
+        {
+          d8[x] = (q[0] << 5) | (q[1] << 2) | q[2];
+        }
+        else
+        {
+          auto dstidx = x * dst_bits;
+          auto shift = (-(int32_t)(dstidx + dst_bits)) & 7;
+          auto tmp = &d8[dstidx >> 3];
+          *tmp = (*tmp & ~(max[0] << shift)) | (q[0] << shift);
+        }
+        x += reverse ? -1 : 1;
+        e += step;
+      }
+      for (size_t c = 0; c < ch; ++c) { e[c - step] = acc0[c]; }
+    }
+
 //----------------------------------------------------------------------------
   }
 }
@@ -85,6 +85,9 @@ namespace lgfx
     uint8_t src_mask  = ~0;
     uint8_t dst_mask  = ~0;
     bool no_convert = false;
+    bool no_dither = false;           // fp_copy を独自の関数に差し替えた場合等、set_dither で変更させない;
+    int32_t dither_x = 0;             // for copy_rgb_dither
+    int32_t dither_y = 0;             // for copy_rgb_dither
 
     pixelcopy_t(void) = default;
 
@@ -102,6 +105,17 @@ namespace lgfx
     static uint32_t compare_bit_affine(void* __restrict dst, uint32_t index, uint32_t last, pixelcopy_t* __restrict param);
     static uint32_t skip_bit_affine(uint32_t index, uint32_t last, pixelcopy_t* param);
 
+    /// 8x8 Bayer matrix, pre-scaled to thresholds 0-255.;
+    static const uint8_t dither_bayer8x8[64];
+
+    /// fp_copy/fp_skip を組織的ディザ付きの変換に差し替える。減色を伴わない組合せの場合は false を返す。;
+    /// 行列の位置は描画先の座標で決まる。dst_pos が false の場合は 元画像の座標 + (dither_x, dither_y) 、;
+    /// true の場合は (index + dither_x, dither_y) を使う。後者は fp_copy を index 0 から始まる行バッファに対して呼ぶ場合に使う。;
+    bool set_dither(bool dst_pos = false);
+
+    /// bgr888 の1行を誤差拡散(Floyd-Steinberg)で dst_depth に変換する。err は (len+2)*3 要素の次行用誤差バッファ。;
+    static void diffuse_row(void* __restrict dst, const bgr888_t* __restrict src, uint32_t len, int16_t* __restrict err, color_depth_t dst_depth, bool reverse);
+
     template<typename TSrc>
     static auto get_fp_copy_rgb_affine(color_depth_t dst_depth) -> uint32_t(*)(void*, uint32_t, uint32_t, pixelcopy_t*)
     {
@@ -135,6 +149,22 @@ namespace lgfx
            : nullptr;
     }
 
+    template<typename TSrc, bool DstPos>
+    static auto get_fp_copy_rgb_dither(color_depth_t dst_depth) -> uint32_t(*)(void*, uint32_t, uint32_t, pixelcopy_t*)
+    {
+      return (dst_depth == rgb565_2Byte) ? (TSrc::bits > 16 ? copy_rgb_dither<swap565_t, TSrc, DstPos> : nullptr)
+           : (dst_depth == rgb332_1Byte) ? (TSrc::bits >  8 ? copy_rgb_dither<rgb332_t , TSrc, DstPos> : nullptr)
+           : ((dst_depth & color_depth_t::bit_mask) < 8) ? copy_rgb_dither<uint8_t, TSrc, DstPos>
+           : nullptr;
+    }
+
+    template<typename TSrc>
+    static auto get_fp_copy_rgb_dither(color_depth_t dst_depth, bool dst_pos) -> uint32_t(*)(void*, uint32_t, uint32_t, pixelcopy_t*)
+    {
+      return dst_pos ? get_fp_copy_rgb_dither<TSrc, true >(dst_depth)
+                     : get_fp_copy_rgb_dither<TSrc, false>(dst_depth);
+    }
+
     template <typename TDst, typename TPalette>
     static uint32_t copy_palette_fast(void* __restrict dst, uint32_t index, uint32_t last, pixelcopy_t* __restrict param)
     {
@@ -199,10 +229,23 @@ namespace lgfx
       auto src_y32_add = param->src_y32_add;
       auto src_x32 = param->src_x32;
       auto src_y32 = param->src_y32;
+      auto transp = param->transp;
+      if (src_y32_add == 0)
+      { // not rotated : the source row is fixed, so only the x position needs to be stepped.
+        auto sr = &s[(src_y32 >> FP_SCALE) * src_bitwidth];
+        do {
+          uint32_t raw = sr[src_x32 >> FP_SCALE].get();
+          if (raw == transp) break;
+          d[index].set(color_convert<TDst, TSrc>(raw));
+          src_x32 += src_x32_add;
+        } while (++index != last);
+        param->src_x32 = src_x32;
+        return index;
+      }
       do {
         uint32_t i = (src_x32 >> FP_SCALE) + (src_y32 >> FP_SCALE) * src_bitwidth;
         uint32_t raw = s[i].get();
-        if (raw == param->transp) break;
+        if (raw == transp) break;
         d[index].set(color_convert<TDst, TSrc>(raw));
         src_x32 += src_x32_add;
         src_y32 += src_y32_add;
@@ -212,6 +255,73 @@ namespace lgfx
       return index;
     }
 
+    static inline void dither_store(swap565_t* d, uint32_t index, uint32_t r, uint32_t g, uint32_t b, uint32_t t, const pixelcopy_t*)
+    {
+      d[index].set(getSwap16((((r * 31 + t) >> 8) << 11) | (((g * 63 + t) >> 8) << 5) | ((b * 31 + t) >> 8)));
+    }
+
+    static inline void dither_store(rgb332_t* d, uint32_t index, uint32_t r, uint32_t g, uint32_t b, uint32_t t, const pixelcopy_t*)
+    {
+      d[index].set((((r * 7 + t) >> 8) << 5) | (((g * 7 + t) >> 8) << 2) | ((b * 3 + t) >> 8));
+    }
+
+    // 1/2/4bit : グレースケールのパレット(setPaletteGrayscale()の状態)のインデックスとして出力する。それ以外のパレットの描画先では LGFXBase 側でディザを使わない;
+    static inline void dither_store(uint8_t* d, uint32_t index, uint32_t r, uint32_t g, uint32_t b, uint32_t t, const pixelcopy_t* param)
+    {
+      uint32_t q = ((((r + (g << 1) + b) >> 2) * param->dst_mask + t) >> 8);
+      auto dstidx = index * param->dst_bits;
+      auto shift = (-(int32_t)(dstidx + param->dst_bits)) & 7;
+      auto tmp = &d[dstidx >> 3];
+      *tmp = (*tmp & ~(param->dst_mask << shift)) | (q << shift);
+    }
+
+    template <typename TDst, typename TSrc, bool DstPos = false>
+    static uint32_t copy_rgb_dither(void* __restrict dst, uint32_t index, uint32_t last, pixelcopy_t* __restrict param)
+    {
+      auto s = static_cast<const TSrc*>(param->src_data);
+      auto d = static_cast<TDst*>(dst);
+      auto src_bitwidth = param->src_bitwidth;
+      auto src_x32_add = param->src_x32_add;
+      auto src_y32_add = param->src_y32_add;
+      auto src_x32 = param->src_x32;
+      auto src_y32 = param->src_y32;
+      auto transp = param->transp;
+      uint32_t dither_x = param->dither_x;
+      uint32_t dither_y = param->dither_y;
+      if (!DstPos && src_y32_add == 0 && src_x32_add == 1 << FP_SCALE)
+      { // not scaled : the source may run over several rows, so the matrix position is tracked separately.
+        uint32_t i = (src_x32 >> FP_SCALE) + (src_y32 >> FP_SCALE) * src_bitwidth;
+        uint32_t sx = i % src_bitwidth;
+        uint32_t tx = sx + dither_x;
+        uint32_t ty = i / src_bitwidth + dither_y;
+        auto start = index;
+        do {
+          auto& c = s[i];
+          if (c.get() == transp) break;
+          dither_store(d, index, c.R8(), c.G8(), c.B8(), dither_bayer8x8[((ty & 7) << 3) + (tx & 7)], param);
+          ++i;
+          ++tx;
+          if (++sx == src_bitwidth) { sx = 0; tx = dither_x; ++ty; }
+        } while (++index != last);
+        param->src_x32 = src_x32 + ((index - start) << FP_SCALE);
+        return index;
+      }
+      do {
+        uint32_t x = src_x32 >> FP_SCALE;
+        uint32_t y = src_y32 >> FP_SCALE;
+        auto& c = s[x + y * src_bitwidth];
+        if (c.get() == transp) break;
+        uint32_t tx = DstPos ? index + dither_x : x + dither_x;
+        uint32_t ty = DstPos ?         dither_y : y + dither_y;
+        dither_store(d, index, c.R8(), c.G8(), c.B8(), dither_bayer8x8[((ty & 7) << 3) + (tx & 7)], param);
+        src_x32 += src_x32_add;
+        src_y32 += src_y32_add;
+      } while (++index != last);
+      param->src_x32 = src_x32;
+      param->src_y32 = src_y32;
+      return index;
+    }
+
     template <typename TDst>
     static uint32_t copy_grayscale_affine(void* __restrict dst, uint32_t index, uint32_t last, pixelcopy_t* __restrict param)
     {
@@ -312,7 +422,7 @@ namespace lgfx
                 uint32_t raw = (s[k >> 3] >> (-(int32_t)(k + src_bits) & 7)) & src_mask;
                 if (!(raw == transp))
                 {
-                  if (std::is_same<TPalette, argb8888_t>::value) { rate *= pal[raw].A8(); }
+                  if (std::is_same<TPalette, argb8888_t>::value) { rate = (rate >> 8) * pal[raw].A8(); } // scaled down so that the sums do not overflow.
                   argb[3] += rate;
                   argb[2] += pal[raw].R8() * rate;
                   argb[1] += pal[raw].G8() * rate;
@@ -340,7 +450,7 @@ namespace lgfx
           }
           else
           {
-            d[index].set( (std::is_same<TPalette, argb8888_t>::value ? a : (a * 255)) / argb[4]
+            d[index].set( (std::is_same<TPalette, argb8888_t>::value ? (a << 8) : (a * 255)) / argb[4]
                         , argb[2] / a
                         , argb[1] / a
                         , argb[0] / a
@@ -372,7 +482,7 @@ namespace lgfx
 
         int32_t x = param->src_x;
         int32_t y = param->src_y;
-        auto color = &s[x + y * src_width];
+        auto color = &s[x + y * (int32_t)src_width];
         if (param->src_x == param->src_xe && param->src_y == param->src_ye && static_cast<uint32_t>(param->src_x) < src_width && static_cast<uint32_t>(param->src_y) < src_height)
         {
           if (!(*color == param->transp))
@@ -398,7 +508,7 @@ namespace lgfx
                && static_cast<uint32_t>(x) < src_width
                && !(*color == param->transp))
               {
-                if (std::is_same<TSrc, argb8888_t>::value) { rate *= color->A8(); }
+                if (std::is_same<TSrc, argb8888_t>::value) { rate = (rate >> 8) * color->A8(); } // scaled down so that the sums do not overflow.
                 argb[3] += rate;
                 argb[2] += color->R8() * rate;
                 argb[1] += color->G8() * rate;
@@ -414,7 +524,7 @@ namespace lgfx
                 if (++y > param->src_ye) break;
                 rate_y = (y == param->src_ye) ? (param->src_ye_lo >> 8) + 1 : 256u;
                 x = param->src_x;
-                color += x + src_width - param->src_xe;
+                color += x + (int32_t)src_width - param->src_xe;
                 rate_x = 256u - (param->src_x_lo >> 8);
               }
             }
@@ -426,7 +536,7 @@ namespace lgfx
           }
           else
           {
-            d[index].set( (std::is_same<TSrc, argb8888_t>::value ? a : (a * 255)) / argb[4]
+            d[index].set( (std::is_same<TSrc, argb8888_t>::value ? (a << 8) : (a * 255)) / argb[4]
                         , argb[2] / a
                         , argb[1] / a
                         , argb[0] / a
@@ -78,6 +78,13 @@ namespace lgfx
   };
 #pragma pack(pop)
 
+  /// 点の座標 (drawPixels 等で使用する);
+  struct point16_t
+  {
+    int16_t x;
+    int16_t y;
+  };
+
 //----------------------------------------------------------------------------
  }
 }
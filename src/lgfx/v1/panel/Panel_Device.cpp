@@ -22,6 +22,8 @@ Contributors:
 #include "../platforms/common.hpp"
 #include "../misc/pixelcopy.hpp"
 
+#include <algorithm>
+
 namespace lgfx
 {
  inline namespace v1
@@ -33,6 +35,11 @@ namespace lgfx
     setBus(nullptr);
   }
 
+  Panel_Device::~Panel_Device(void)
+  {
+    if (_touch_events) { heap_free(_touch_events); }
+  }
+
   void Panel_Device::setBus(IBus* bus)
   {
     static Bus_NULL nullobj;
@@ -74,6 +81,11 @@ namespace lgfx
   {
     if (_touch)
     {
+      // updateTouch はタイマ等から呼ばれるため、キューはここで確保しておく;
+      if (_touch_events == nullptr)
+      {
+        _touch_events = static_cast<touch_event_t*>(heap_alloc(TOUCH_EVENT_QUEUE_SIZE * sizeof(touch_event_t)));
+      }
       return _touch->init();
     }
     return false;
@@ -228,6 +240,81 @@ namespace lgfx
     }
   }
 
+  void Panel_Device::drawPixelsPreclipped(const point16_t* points, uint32_t count, const uint32_t* rawcolors, uint32_t rawcolor)
+  {
+    // 点を行毎に x の順に並べ替え、横に連続する点を1回の setWindow にまとめる;
+    // 上位32bitに座標、下位32bitに元の順番を持たせ、同じ座標の点は後の点の色が残るようにする;
+    // 一度に並べ替える点の数は最大 heap_len 点とし、確保できない場合はスタック上の領域を使う;
+    static constexpr uint32_t stack_len = 32;
+    static constexpr uint32_t heap_len = 1024;
+    uint64_t stack_keys[stack_len];
+    uint32_t chunk_len = count < heap_len ? count : heap_len;
+    uint64_t* keys = (chunk_len > stack_len) ? (uint64_t*)heap_alloc(chunk_len * sizeof(uint64_t)) : nullptr;
+    if (keys == nullptr)
+    {
+      keys = stack_keys;
+      chunk_len = stack_len;
+    }
+    startWrite();
+    while (count)
+    {
+      uint32_t len = count < chunk_len ? count : chunk_len;
+      for (uint32_t i = 0; i < len; ++i)
+      {
+        uint32_t pos = (uint32_t)(uint16_t)points[i].y << 16 | (uint16_t)points[i].x;
+        keys[i] = (uint64_t)pos << 32 | i;
+      }
+      std::sort(keys, keys + len);
+
+      uint32_t i = 0;
+      do
+      {
+        uint32_t pos = keys[i] >> 32;
+        uint32_t last = pos;
+        uint32_t j = i;
+        while (++j < len)
+        {
+          uint32_t p = keys[j] >> 32;
+          if (p != last && (p != last + 1 || (p >> 16) != (pos >> 16))) { break; }
+          last = p;
+        }
+        uint_fast16_t x = pos & 0xFFFF;
+        uint_fast16_t y = pos >> 16;
+        uint_fast16_t w = last - pos + 1;
+        if (rawcolors == nullptr)
+        {
+          writeFillRectPreclipped(x, y, w, 1, rawcolor);
+        }
+        else
+        {
+          setWindow(x, y, x + w - 1, y);
+          uint32_t color = 0;
+          uint32_t repeat = 0;
+          for (; i < j; ++i)
+          {
+            if (i + 1 < j && (keys[i] >> 32) == (keys[i + 1] >> 32)) { continue; }
+            uint32_t c = rawcolors[(uint32_t)keys[i]];
+            if (repeat && color != c)
+            {
+              writeBlock(color, repeat);
+              repeat = 0;
+            }
+            color = c;
+            ++repeat;
+          }
+          writeBlock(color, repeat);
+        }
+        i = j;
+      } while (i < len);
+
+      points += len;
+      if (rawcolors) { rawcolors += len; }
+      count -= len;
+    }
+    endWrite();
+    if (keys != stack_keys) { heap_free(keys); }
+  }
+
   void Panel_Device::copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y)
   {
     pixelcopy_t pc_read( (void*)nullptr, _write_depth, _read_depth);
@@ -467,6 +554,94 @@ namespace lgfx
     return res;
   }
 
+  bool Panel_Device::updateTouch(void)
+  {
+    if (_touch == nullptr || _touch_events == nullptr) return false;
+
+    auto cfg = _touch->config();
+    uint32_t msec = millis();
+    bool notified = _touch_notified;
+    if (!notified)
+    {
+      // 割込みピンがある場合、触れていない間は割込みが来るまでバス通信を行わない;
+      // (触れている間は、離したことを検出するため一定周期で取得する);
+      bool int_active = (cfg.pin_int >= 0) && !gpio_in(cfg.pin_int);
+      if (!int_active && !((cfg.pin_int < 0 || _touch_last_count) && (msec - _touch_msec >= _touch_interval)))
+      {
+        return false;
+      }
+    }
+    // 共有バスでDMA転送中であれば、転送を止めないよう次回 (転送の合間) に見送る;
+    // ただし要求から setTouchLatency の時間を過ぎた場合は転送の完了を待って取得する;
+    if (cfg.bus_shared && getStartCount() && dmaBusy())
+    {
+      if (!_touch_deferred)
+      {
+        _touch_deferred = true;
+        _touch_request_msec = msec;
+      }
+      if (msec - _touch_request_msec < _touch_latency)
+      {
+        _touch_notified = true;  // 割込みピンが戻っても次回に取得する;
+        return false;
+      }
+      waitDMA();
+    }
+    _touch_deferred = false;
+    _touch_notified = false;
+
+    _touch_msec = msec;
+
+    static constexpr uint_fast8_t max_points = 5;
+    touch_point_t tp[max_points];
+    uint_fast8_t count = getTouch(tp, max_points);
+    if (count == 0)
+    {
+      if (_touch_last_count == 0) { return true; }
+      tp[0] = touch_point_t();
+    }
+    _touch_last_count = count;
+
+    uint_fast8_t i = 0;
+    do
+    {
+      push_touch_event(tp[i], msec, count);
+    } while (++i < count);
+    return true;
+  }
+
+  void Panel_Device::push_touch_event(const touch_point_t& tp, uint32_t msec, uint8_t count)
+  {
+    static constexpr uint8_t mask = TOUCH_EVENT_QUEUE_SIZE - 1;
+    uint8_t head = _touch_event_head.load(std::memory_order_relaxed);
+    uint8_t tail = _touch_event_tail.load(std::memory_order_acquire);
+    // 満杯の場合は古い押下/移動を捨てて上書きする。最後の1枠は離した事象のために空けておく;
+    // (離した事象は捨てない。最も古い事象が離した事象であれば新しい押下/移動の方を捨てる);
+    while ((uint8_t)(head - tail) >= TOUCH_EVENT_QUEUE_SIZE - (count != 0))
+    {
+      if (count && _touch_events[tail & mask].count == 0) { return; }
+      // 取り出し側と競合した場合は tail が更新されるので再判定する;
+      if (_touch_event_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel, std::memory_order_acquire)) { ++tail; }
+    }
+    auto &ev = _touch_events[head & mask];
+    ev.point = tp;
+    ev.msec = msec;
+    ev.count = count;
+    _touch_event_head.store(head + 1, std::memory_order_release);
+  }
+
+  bool Panel_Device::getTouchEvent(touch_event_t* event)
+  {
+    uint8_t tail = _touch_event_tail.load(std::memory_order_acquire);
+    do
+    {
+      if (tail == _touch_event_head.load(std::memory_order_acquire)) { return false; }
+      *event = _touch_events[tail & (TOUCH_EVENT_QUEUE_SIZE - 1)];
+      // 読んでいる間に updateTouch がこの事象を捨てた場合は読み直す;
+    } while (!_touch_event_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel, std::memory_order_acquire));
+    return true;
+  }
+
 //----------------------------------------------------------------------------
 
  }
@@ -19,6 +19,8 @@ Contributors:
 
 #include "../Panel.hpp"
 
+#include <atomic>
+
 namespace lgfx
 {
  inline namespace v1
@@ -28,11 +30,13 @@ namespace lgfx
   struct ILight;
   struct ITouch;
   struct touch_point_t;
+  struct touch_event_t;
 
   struct Panel_Device : public IPanel
   {
   public:
     Panel_Device(void);
+    virtual ~Panel_Device(void);
 
     struct config_t
     {
@@ -139,6 +143,21 @@ namespace lgfx
     void setCalibrateAffine(float affine[6]);
     void setCalibrate(uint16_t *parameters);
 
+    /// タッチの状態を取得し、変化があればイベントキューに積む。描画ループとは別の周期 (タイマ等) で呼び出す;
+    /// pin_int が設定されている場合、触れていない間は割込みピンを確認するだけでバス通信を行わない;
+    /// 共有バスでDMA転送中の場合は取得を見送り (falseを返す)、転送の合間に取得する;
+    /// キューが満杯の場合は古い押下/移動を捨てる。離した事象は捨てない;
+    bool updateTouch(void);
+    /// 割込みハンドラから呼び出し、次回のupdateTouchで確実に取得させる (バス通信は行わない);
+    void notifyTouch(void) { _touch_notified = true; }
+    /// キューからイベントを1つ取り出す。バス通信は行わない;
+    bool getTouchEvent(touch_event_t* event);
+    uint_fast8_t getTouchEventCount(void) const { return (uint8_t)(_touch_event_head.load(std::memory_order_acquire) - _touch_event_tail.load(std::memory_order_relaxed)); }
+    /// pin_int がない場合、及び触れている間の取得間隔 (msec);
+    void setTouchInterval(uint16_t msec) { _touch_interval = msec; }
+    /// 共有バスでDMA転送中のため取得を見送る最大時間 (msec)。超えた場合は転送の完了を待って取得する;
+    void setTouchLatency(uint16_t msec) { _touch_latency = msec; }
+
 
     bool isReadable(void) const override { return _cfg.readable; }
     bool isBusShared(void) const override { return _cfg.bus_shared; }
@@ -153,6 +172,7 @@ namespace lgfx
     //void writePixelsDMA(const uint8_t* data, uint32_t length) override;
     void writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param) override;
     void copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y) override;
+    void drawPixelsPreclipped(const point16_t* points, uint32_t count, const uint32_t* rawcolors, uint32_t rawcolor) override;
 
   protected:
 
@@ -168,6 +188,20 @@ namespace lgfx
 
     float _affine[6] = {1,0,0,0,1,0};  /// touch affine parameter
 
+    static constexpr uint8_t TOUCH_EVENT_QUEUE_SIZE = 16; // 2の累乗であること;
+    touch_event_t* _touch_events = nullptr;
+    std::atomic<uint8_t> _touch_event_head { 0 };  /// updateTouch のみが進める;
+    std::atomic<uint8_t> _touch_event_tail { 0 };  /// getTouchEvent が進める (満杯の場合は updateTouch も進める);
+    volatile bool _touch_notified = false;
+    bool _touch_deferred = false;
+    uint8_t _touch_last_count = 0;
+    uint16_t _touch_interval = 16;
+    uint16_t _touch_latency = 50;
+    uint32_t _touch_msec = 0;
+    uint32_t _touch_request_msec = 0;
+
+    void push_touch_event(const touch_point_t& tp, uint32_t msec, uint8_t count);
+
     /// CSピンの準備処理を行う。CSピンを自前で制御する場合、この関数をoverrideして実装すること。;
     /// Performs preparation processing for the CS pin.
     /// If you want to control the CS pin on your own, override this function and implement it.
@@ -36,7 +36,11 @@ namespace lgfx
       _cfg.dummy_read_pixel = 16;
     }
 
-    void setWindow(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye) override
+    static constexpr bool static_window = false;
+
+  protected:
+
+    void setWindow_impl(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye) override
     {
       if (xs != _xs || xe != _xe || ys != _ys || ye != _ye)
       {
@@ -62,8 +66,6 @@ namespace lgfx
       _bus->writeCommand(CMD_RAMWR, 8);
     }
 
-  protected:
-
     uint8_t getMadCtl(uint8_t r) const override
     {
       static constexpr uint8_t madctl_table[] =
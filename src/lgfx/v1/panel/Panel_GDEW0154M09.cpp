@@ -108,6 +108,14 @@ namespace lgfx
       _range_mod.bottom = std::max<int16_t>(_range_mod.bottom, y + h - 1);
     }
     if (_range_mod.empty()) { return; }
+    if (!_shadow_narrow(_range_mod, (_cfg.panel_width + 7) >> 3, 3))
+    { // 内容が変化していないので、部分更新を行わない;
+      _range_mod.top    = INT16_MAX;
+      _range_mod.left   = INT16_MAX;
+      _range_mod.right  = 0;
+      _range_mod.bottom = 0;
+      return;
+    }
     _close_transfer();
     _range_old = _range_mod;
     while (millis() - _send_msec < _refresh_msec) delay(1);
@@ -122,6 +130,7 @@ namespace lgfx
       _exec_transfer(0x10, _range_mod, true);
     }
     _exec_transfer(0x13, _range_mod);
+    _shadow_update(_range_mod, (_cfg.panel_width + 7) >> 3, 3);
     _range_mod.top    = INT16_MAX;
     _range_mod.left   = INT16_MAX;
     _range_mod.right  = 0;
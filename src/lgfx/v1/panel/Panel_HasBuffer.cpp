@@ -20,6 +20,8 @@ Contributors:
 #include "../platforms/common.hpp"
 #include "../Bus.hpp"
 
+#include <string.h>
+
 namespace lgfx
 {
  inline namespace v1
@@ -29,6 +31,7 @@ namespace lgfx
   Panel_HasBuffer::~Panel_HasBuffer(void)
   {
     if (_buf) { heap_free(_buf); }
+    if (_shadow) { heap_free(_shadow); }
   }
 
   Panel_HasBuffer::Panel_HasBuffer(void) : Panel_Device()
@@ -46,10 +49,103 @@ namespace lgfx
     auto len = _get_buffer_length();
     if (_buf) heap_free(_buf);
     _buf = static_cast<uint8_t*>(heap_alloc_dma(len));
+    if (_buf) { setShadowBuffer(_use_shadow); }
 
     return ((_buf != nullptr) && (Panel_Device::init(use_reset)));
   }
 
+  bool Panel_HasBuffer::setShadowBuffer(bool enable)
+  {
+    _use_shadow = enable;
+    _shadow_valid = false;
+    if (_shadow) { heap_free(_shadow); _shadow = nullptr; }
+    if (!enable || !_buf) { return true; }   /// 初期化前の場合はinit時に確保する;
+
+    // 次回のdisplayで送信した後に内容を複製し、それ以降の比較に使用する;
+    _shadow = static_cast<uint8_t*>(heap_alloc(_get_buffer_length()));
+    return _shadow != nullptr;
+  }
+
+  bool Panel_HasBuffer::_shadow_diff(size_t offset, uint_fast16_t &first, uint_fast16_t &last) const
+  {
+    if (!_shadow_valid) { return true; }
+    auto a = &_buf[offset];
+    auto b = &_shadow[offset];
+    size_t l = first;
+    size_t r = last + 1;
+
+    while (l < r && ((offset + l) & 3) && a[l] == b[l]) { ++l; }
+    if (((offset + l) & 3) == 0)
+    {
+      while (l + 4 <= r && *reinterpret_cast<const uint32_t*>(&a[l]) == *reinterpret_cast<const uint32_t*>(&b[l])) { l += 4; }
+    }
+    while (l < r && a[l] == b[l]) { ++l; }
+    if (l == r) { return false; }
+
+    // a[l] != b[l] なので以下のループは l で必ず止まる;
+    while (((offset + r) & 3) && a[r - 1] == b[r - 1]) { --r; }
+    if (((offset + r) & 3) == 0)
+    {
+      while (l + 4 <= r && *reinterpret_cast<const uint32_t*>(&a[r - 4]) == *reinterpret_cast<const uint32_t*>(&b[r - 4])) { r -= 4; }
+    }
+    while (a[r - 1] == b[r - 1]) { --r; }
+
+    first = l;
+    last = r - 1;
+    return true;
+  }
+
+  bool Panel_HasBuffer::_shadow_narrow(range_rect_t &range, size_t stride, uint_fast8_t shift) const
+  {
+    if (!_shadow_valid) { return true; }
+    int_fast16_t rows = _get_buffer_length() / stride;
+    int_fast16_t ys = std::max<int_fast16_t>(0, range.top);
+    int_fast16_t ye = std::min<int_fast16_t>(rows - 1, range.bottom);
+    uint_fast16_t xs = std::max<int_fast16_t>(0, range.left) >> shift;
+    uint_fast16_t xe = std::min<int_fast16_t>(stride - 1, range.right >> shift);
+    if (ye < ys || xe < xs) { return false; }
+
+    int_fast16_t top = INT16_MAX, bottom = -1;
+    uint_fast16_t left = UINT16_MAX, right = 0;
+    for (int_fast16_t y = ys; y <= ye; ++y)
+    {
+      uint_fast16_t l = xs, r = xe;
+      if (!_shadow_diff(y * stride, l, r)) { continue; }
+      if (top > y) { top = y; }
+      bottom = y;
+      if (left > l) { left = l; }
+      if (right < r) { right = r; }
+    }
+    if (bottom < 0) { return false; }
+
+    range.top    = top;
+    range.bottom = bottom;
+    range.left   = left << shift;
+    range.right  = ((right + 1) << shift) - 1;
+    return true;
+  }
+
+  void Panel_HasBuffer::_shadow_update(const range_rect_t &range, size_t stride, uint_fast8_t shift)
+  {
+    if (!_shadow) { return; }
+    if (!_shadow_valid)
+    { /// 送信範囲外は既にパネルと同じ内容なので、全体を複製してよい;
+      memcpy(_shadow, _buf, _get_buffer_length());
+      _shadow_valid = true;
+      return;
+    }
+    int_fast16_t rows = _get_buffer_length() / stride;
+    int_fast16_t ys = std::max<int_fast16_t>(0, range.top);
+    int_fast16_t ye = std::min<int_fast16_t>(rows - 1, range.bottom);
+    int_fast16_t xs = std::max<int_fast16_t>(0, range.left) >> shift;
+    int_fast16_t xe = std::min<int_fast16_t>(stride - 1, range.right >> shift);
+    if (ye < ys || xe < xs) { return; }
+    for (int_fast16_t y = ys; y <= ye; ++y)
+    {
+      memcpy(&_shadow[y * stride + xs], &_buf[y * stride + xs], xe - xs + 1);
+    }
+  }
+
   void Panel_HasBuffer::beginTransaction(void)
   {
     if (_in_transaction) return;
@@ -44,14 +44,29 @@ namespace lgfx
     void drawPixelPreclipped(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor) override;
     void writeBlock(uint32_t rawcolor, uint32_t length) override;
 
+    /// 前回displayで送信した内容の複製を保持し、display時には内容が変化した部分だけを送信する;
+    /// ( 毎フレーム全体を描き直すような使い方で、同じ内容の再送信を省く );
+    bool setShadowBuffer(bool enable);
+    bool getShadowBuffer(void) const { return _use_shadow; }
+
   protected:
     uint8_t* _buf = nullptr;
+    uint8_t* _shadow = nullptr;
     range_rect_t _range_mod;
     int32_t _xpos = 0;
     int32_t _ypos = 0;
     bool _in_transaction = false;
+    bool _use_shadow = false;
+    bool _shadow_valid = false;
 
     virtual size_t _get_buffer_length(void) const = 0;
+
+    /// バッファ1行のうち first~last byte の範囲を、送信済みの内容と異なる範囲に狭める。同一ならfalse;
+    bool _shadow_diff(size_t offset, uint_fast16_t &first, uint_fast16_t &last) const;
+    /// range ( 横はピクセル単位 1byte = 1<<shift pixel、縦はバッファの行単位 ) を内容が変化した範囲に狭める。変化がなければfalse;
+    bool _shadow_narrow(range_rect_t &range, size_t stride, uint_fast8_t shift) const;
+    /// 送信済みの範囲をshadowに反映する;
+    void _shadow_update(const range_rect_t &range, size_t stride, uint_fast8_t shift);
     void _rotate_pos(uint_fast16_t &x, uint_fast16_t &y);
     void _rotate_pos(uint_fast16_t &xs, uint_fast16_t &ys, uint_fast16_t &xe, uint_fast16_t &ye);
   };
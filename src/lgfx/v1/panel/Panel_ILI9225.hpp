@@ -32,6 +32,7 @@ namespace lgfx
       _cfg.memory_width  = _cfg.panel_width  = 176;
       _cfg.memory_height = _cfg.panel_height = 220;
       _cfg.readable = false; // RW pin not supported.
+      _cmd_vscrdef = 0;  // ハードウェアスクロールのコマンド体系が異なるため使用しない;
 //    _cmd_ramrd = CMD_RAMWR;
     }
 
@@ -143,6 +143,9 @@ namespace lgfx
     _xs = _xe = _ys = _ye = INT16_MAX;
 
     update_madctl();
+
+    // 回転方向が変わるとスクロール範囲の意味が変わるため解除する;
+    if (_vs_h) { vscroll_reset(); }
   }
 
   void Panel_LCD::update_madctl(void)
@@ -207,6 +210,28 @@ namespace lgfx
   }
 
   void Panel_LCD::setWindow(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye)
+  {
+    _vs_split = 0;
+    if (_vs_shift)
+    {
+      uint_fast16_t rows = vscroll_rows(ys, ye - ys + 1);
+      if (ys + rows <= ye)
+      { // 折返しを跨ぐ場合は前半のみ設定し、後半は writeBlock / writePixels で切り替える;
+        _vs_split = rows * (xe - xs + 1);
+        _vs_xs = xs;
+        _vs_ys = ys + rows;
+        _vs_xe = xe;
+        _vs_ye = ye;
+        ye = ys + rows - 1;
+      }
+      uint_fast16_t y = vscroll_map(ys);
+      ye += y - ys;
+      ys = y;
+    }
+    setWindow_impl(xs, ys, xe, ye);
+  }
+
+  void Panel_LCD::setWindow_impl(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye)
   {
     if (!_cfg.dlen_16bit)
     {
@@ -232,16 +257,36 @@ namespace lgfx
 
   void Panel_LCD::writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
   {
-    uint32_t len = w * h;
     uint_fast16_t xe = w + x - 1;
-    uint_fast16_t ye = y + h - 1;
-
-    setWindow(x,y,xe,ye);
-    if (_cfg.dlen_16bit) { _has_align_data = (_write_bits & 15) && (len & 1); }
-    _bus->writeDataRepeat(rawcolor, _write_bits, len);
+    do
+    {
+      uint_fast16_t rows = vscroll_rows(y, h);
+      uint32_t len = w * rows;
+      setWindow(x, y, xe, y + rows - 1);
+      if (_cfg.dlen_16bit) { _has_align_data = (_write_bits & 15) && (len & 1); }
+      _bus->writeDataRepeat(rawcolor, _write_bits, len);
+      y += rows;
+      h -= rows;
+    } while (h);
   }
 
   void Panel_LCD::writeBlock(uint32_t rawcolor, uint32_t len)
+  {
+    while (_vs_split && len >= _vs_split)
+    {
+      auto l = _vs_split;
+      write_block(rawcolor, l);
+      len -= l;
+      setWindow(_vs_xs, _vs_ys, _vs_xe, _vs_ye);
+    }
+    if (len)
+    {
+      _vs_split -= (_vs_split) ? len : 0;
+      write_block(rawcolor, len);
+    }
+  }
+
+  void Panel_LCD::write_block(uint32_t rawcolor, uint32_t len)
   {
     _bus->writeDataRepeat(rawcolor, _write_bits, len);
     if (_cfg.dlen_16bit && (_write_bits & 15) && (len & 1))
@@ -251,6 +296,22 @@ namespace lgfx
   }
 
   void Panel_LCD::writePixels(pixelcopy_t* param, uint32_t len, bool use_dma)
+  {
+    while (_vs_split && len >= _vs_split)
+    {
+      auto l = _vs_split;
+      write_pixels(param, l, use_dma);
+      len -= l;
+      setWindow(_vs_xs, _vs_ys, _vs_xe, _vs_ye);
+    }
+    if (len)
+    {
+      _vs_split -= (_vs_split) ? len : 0;
+      write_pixels(param, len, use_dma);
+    }
+  }
+
+  void Panel_LCD::write_pixels(pixelcopy_t* param, uint32_t len, bool use_dma)
   {
     if (param->no_convert)
     {
@@ -267,6 +328,28 @@ namespace lgfx
   }
 
   void Panel_LCD::writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool use_dma)
+  {
+    uint_fast16_t rows = vscroll_rows(y, h);
+    if (rows == h)
+    {
+      write_image(x, y, w, h, param, use_dma);
+      return;
+    }
+    // スクロール範囲の折返しで分割する;
+    auto src_x = param->src_x;
+    auto src_y = param->src_y;
+    do
+    {
+      param->src_x = src_x;
+      param->src_y = src_y;
+      write_image(x, y, w, rows, param, use_dma);
+      src_y += rows;
+      y += rows;
+      h -= rows;
+    } while (h && (rows = vscroll_rows(y, h)));
+  }
+
+  void Panel_LCD::write_image(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool use_dma)
   {
     auto bytes = param->dst_bits >> 3;
     auto src_x = param->src_x;
@@ -389,6 +472,18 @@ namespace lgfx
   }
 
   void Panel_LCD::readRect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param)
+  {
+    do
+    {
+      uint_fast16_t rows = vscroll_rows(y, h);
+      read_rect(x, y, w, rows, dst, param);
+      dst = &((uint8_t*)dst)[(w * rows * param->dst_bits) >> 3];
+      y += rows;
+      h -= rows;
+    } while (h);
+  }
+
+  void Panel_LCD::read_rect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param)
   {
     uint_fast16_t bytes = param->dst_bits >> 3;
     auto len = w * h;
@@ -425,26 +520,100 @@ namespace lgfx
     if (_in_transaction) { cs_control(false); }
   }
 
-  void Panel_LCD::set_window_8(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye, uint32_t cmd)
+  void Panel_LCD::write_param16(uint_fast16_t data)
+  {
+    if (!_cfg.dlen_16bit)
+    {
+      _bus->writeData((data >> 8) | (data & 0xFF) << 8, 16);
+    }
+    else
+    {
+      _bus->writeData((data >> 8) << 8 | data << 24, 32);
+    }
+  }
+
+  uint_fast16_t Panel_LCD::vscroll_rows(uint_fast16_t y, uint_fast16_t h) const
+  {
+    if (!_vs_shift) { return h; }
+    uint_fast16_t lim;
+    if (y < _vs_y) { lim = _vs_y - y; }
+    else
+    {
+      uint_fast16_t j = y - _vs_y;
+      if (j >= _vs_h) { return h; }
+      uint_fast16_t wrap = _vs_h - _vs_shift;
+      lim = (j < wrap ? wrap : _vs_h) - j;
+    }
+    return lim < h ? lim : h;
+  }
+
+  uint_fast16_t Panel_LCD::vscroll_map(uint_fast16_t y) const
+  {
+    uint_fast16_t j = y - _vs_y;
+    if (!_vs_shift || y < _vs_y || j >= _vs_h) { return y; }
+    j += _vs_shift;
+    if (j >= _vs_h) { j -= _vs_h; }
+    return _vs_y + j;
+  }
+
+  void Panel_LCD::vscroll_reset(void)
   {
-    static constexpr uint32_t mask = 0xFF00FF;
-    uint32_t x = xs + (xe << 16);
-    if (_xsxe != x)
+    _vs_y = _vs_h = _vs_shift = 0;
+    _vs_split = 0;
+    if (_bus == nullptr) { return; }
+    startWrite();
+    write_command(CMD_VSCRDEF);
+    write_param16(0);
+    write_param16(_cfg.memory_height);
+    write_param16(0);
+    write_command(CMD_VSCRSADD);
+    write_param16(0);
+    endWrite();
+  }
+
+  bool Panel_LCD::scrollVertical(uint_fast16_t y, uint_fast16_t h, int_fast16_t dy)
+  {
+    // 行と列を入れ替えない向きのみ対応する。上下反転を MAD_VF で行うパネル (ILI9481等) も対象外;
+    auto madctl = getMadCtl(_internal_rotation);
+    if (!_cmd_vscrdef || _bus == nullptr || (madctl & (MAD_MV | MAD_VF)) || h < 2 || y + h > _height)
     {
-      _xsxe = x;
-      _bus->writeCommand(CMD_CASET, 8);
-      x += _colstart + (_colstart << 16);
-      _bus->writeData(((x >> 8) & mask) + ((x & mask) << 8), 32);
+      return false;
     }
-    uint32_t y = ys + (ye << 16);
-    if (_ysye != y)
+    bool mirror = madctl & MAD_MY;
+    if (_vs_y != y || _vs_h != h)
     {
-      _ysye = y;
-      _bus->writeCommand(CMD_RASET, 8);
-      y += _rowstart + (_rowstart << 16);
-      _bus->writeData(((y >> 8) & mask) + ((y & mask) << 8), 32);
+      // 別の範囲で画面がずれている間は使用しない (呼出し側で copyRect を用いる);
+      if (_vs_shift) { return false; }
+      uint_fast16_t top = y + _rowstart;
+      if (mirror) { top = _cfg.memory_height - (top + h); }
+      _vs_y = y;
+      _vs_h = h;
+      _vs_top = top;
+      startWrite();
+      write_command(_cmd_vscrdef);
+      write_param16(top);
+      write_param16(h);
+      write_param16(_cfg.memory_height - (top + h));
+      endWrite();
     }
-    _bus->writeCommand(cmd, 8);
+    // 描画時には論理座標の行に _vs_shift を加えた位置に書き込む;
+    int32_t shift = ((int32_t)_vs_shift - dy) % (int32_t)h;
+    if (shift < 0) { shift += h; }
+    _vs_shift = shift;
+    _xs = _xe = _ys = _ye = INT16_MAX;
+    _xsxe = _ysye = ~0u;
+
+    uint_fast16_t offset = (mirror && shift) ? h - shift : shift;
+    startWrite();
+    write_command(CMD_VSCRSADD);
+    write_param16(_vs_top + offset);
+    endWrite();
+    return true;
+  }
+
+  void Panel_LCD::set_window_8(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye, uint32_t cmd)
+  {
+    set_window_8(_bus, xs, ys, xe, ye, cmd);
   }
 
   void Panel_LCD::set_window_16(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye, uint32_t cmd)
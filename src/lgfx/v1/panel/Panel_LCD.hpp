@@ -53,6 +53,33 @@ namespace lgfx
     uint32_t readData(uint_fast8_t index, uint_fast8_t len) override;
     void readRect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param) override;
 
+    bool scrollVertical(uint_fast16_t y, uint_fast16_t h, int_fast16_t dy) override;
+
+    /// setWindow_impl を置き換える派生クラスでは false にする (LGFX_Static の直接描画を行わない);
+    static constexpr bool static_window = true;
+
+    /// LGFX_Static 用。バスの型が確定している場合に仮想関数を経由せずに描画する;
+    /// トランザクション外、16bitパラメータ、ハードウェアスクロール中は何もせず false を返す;
+    template <typename TBus>
+    bool drawPixelPreclipped_static(TBus* bus, uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor)
+    {
+      if (!_in_transaction || _cfg.dlen_16bit || _vs_shift) { return false; }
+      _vs_split = 0;
+      set_window_8(bus, x, y, x, y, CMD_RAMWR);
+      bus->writeData(rawcolor, _write_bits);
+      return true;
+    }
+
+    template <typename TBus>
+    bool writeFillRectPreclipped_static(TBus* bus, uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
+    {
+      if (!_in_transaction || _cfg.dlen_16bit || _vs_shift) { return false; }
+      _vs_split = 0;
+      set_window_8(bus, x, y, x + w - 1, y + h - 1, CMD_RAMWR);
+      bus->writeDataRepeat(rawcolor, _write_bits, w * h);
+      return true;
+    }
+
   protected:
 
     uint16_t _colstart = 0;
@@ -60,6 +87,16 @@ namespace lgfx
     bool _in_transaction = false;
     uint8_t _cmd_nop = CMD_NOP;
     uint8_t _cmd_ramrd = CMD_RAMRD;
+    uint8_t _cmd_vscrdef = CMD_VSCRDEF;  // 0の場合はハードウェアスクロールを使用しない;
+
+    // ハードウェアスクロールの範囲 (論理座標) と、描画時に加える行のずれ;
+    uint16_t _vs_y = 0;
+    uint16_t _vs_h = 0;
+    uint16_t _vs_shift = 0;
+    uint16_t _vs_top = 0;  // スクロール範囲の先頭 (GRAM上の行);
+    // setWindow の範囲がスクロール範囲の折返しを跨ぐ場合の、前半の残り画素数と後半の範囲;
+    uint32_t _vs_split = 0;
+    uint16_t _vs_xs, _vs_ys, _vs_xe, _vs_ye;
 
     enum mad_t
     { MAD_MY  = 0x80
@@ -113,7 +150,9 @@ namespace lgfx
     static constexpr uint8_t CMD_PASET   = 0x2B;
     static constexpr uint8_t CMD_RAMWR   = 0x2C;
     static constexpr uint8_t CMD_RAMRD   = 0x2E;
+    static constexpr uint8_t CMD_VSCRDEF = 0x33;
     static constexpr uint8_t CMD_MADCTL  = 0x36;
+    static constexpr uint8_t CMD_VSCRSADD= 0x37;
     static constexpr uint8_t CMD_IDMOFF  = 0x38;
     static constexpr uint8_t CMD_IDMON   = 0x39;
     static constexpr uint8_t CMD_COLMOD  = 0x3A;
@@ -126,7 +165,43 @@ namespace lgfx
     void write_command(uint32_t data);
     void write_bytes(const uint8_t* data, uint32_t len, bool use_dma);
     void set_window_8(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye, uint32_t cmd);
+    template <typename TBus>
+    void set_window_8(TBus* bus, uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye, uint32_t cmd)
+    {
+      static constexpr uint32_t mask = 0xFF00FF;
+      uint32_t x = xs + (xe << 16);
+      if (_xsxe != x)
+      {
+        _xsxe = x;
+        bus->writeCommand(CMD_CASET, 8);
+        x += _colstart + (_colstart << 16);
+        bus->writeData(((x >> 8) & mask) + ((x & mask) << 8), 32);
+      }
+      uint32_t y = ys + (ye << 16);
+      if (_ysye != y)
+      {
+        _ysye = y;
+        bus->writeCommand(CMD_RASET, 8);
+        y += _rowstart + (_rowstart << 16);
+        bus->writeData(((y >> 8) & mask) + ((y & mask) << 8), 32);
+      }
+      bus->writeCommand(cmd, 8);
+    }
     void set_window_16(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye, uint32_t cmd);
+    void write_param16(uint_fast16_t data);
+
+    /// スクロールによる行のずれを反映しない setWindow;
+    virtual void setWindow_impl(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye);
+
+    void write_block(uint32_t rawcolor, uint32_t len);
+    void write_pixels(pixelcopy_t* param, uint32_t len, bool use_dma);
+    void write_image(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool use_dma);
+    void read_rect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param);
+
+    /// y から始まる h 行のうち、GRAM上で連続している行数;
+    uint_fast16_t vscroll_rows(uint_fast16_t y, uint_fast16_t h) const;
+    uint_fast16_t vscroll_map(uint_fast16_t y) const;
+    void vscroll_reset(void);
 
     virtual void update_madctl(void);
 
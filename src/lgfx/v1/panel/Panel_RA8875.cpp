@@ -123,6 +123,10 @@ namespace lgfx
     {
       _write_reg(reg, 0);
     }
+    for (size_t reg = 0x91; reg <= 0xAC; ++reg)
+    {
+      _write_reg(reg, 0);
+    }
 
     return true;
   }
@@ -248,16 +252,18 @@ namespace lgfx
     else
     {
       _bus->flush();
+      uint32_t r = reg;
+      uint32_t d = data;
       uint_fast8_t len = 8;
       if (_cfg.dlen_16bit)
-      {
+      { // uint8_t のままシフトすると値が失われるため32bitで扱う;
         len <<= 1;
-        reg <<= 8;
-        data <<= 8;
+        r <<= 8;
+        d <<= 8;
       }
       _wait_busy();
-      _bus->writeCommand(reg, len);
-      _bus->writeData(data, len);
+      _bus->writeCommand(r, len);
+      _bus->writeData(d, len);
     }
   }
 
@@ -272,6 +278,57 @@ namespace lgfx
     _write_reg(reg, data);
   }
 
+  void Panel_RA8875::_write_reg_0x91(uint8_t reg, uint8_t data)
+  {
+    size_t index = reg - 0x91;
+    if (index < sizeof(_reg_0x91))
+    {
+      if (_reg_0x91[index] == data) { return; }
+      _reg_0x91[index] = data;
+    }
+    _write_reg(reg, data);
+  }
+
+  void Panel_RA8875::_write_pos_0x91(uint8_t reg, uint_fast16_t x, uint_fast16_t y)
+  {
+    _write_reg_0x91(reg    , x     );
+    _write_reg_0x91(reg + 1, x >> 8);
+    _write_reg_0x91(reg + 2, y     );
+    _write_reg_0x91(reg + 3, y >> 8);
+  }
+
+  void Panel_RA8875::_rotate_pos(uint_fast16_t& x, uint_fast16_t& y) const
+  {
+    uint_fast8_t r = _internal_rotation;
+    if (r)
+    {
+      if ((1u << r) & 0b10010110) { y = _height - (y + 1); }
+      if (r & 2)                  { x = _width  - (x + 1); }
+      if (r & 1) { std::swap(x, y); }
+    }
+    x += _colstart;
+    y += _rowstart;
+  }
+
+  void Panel_RA8875::_set_fgcolor(uint32_t rawcolor)
+  {
+    if (_latestcolor == rawcolor) { return; }
+    _latestcolor = rawcolor;
+    if (_write_depth == rgb565_2Byte)
+    {
+      rawcolor = getSwap16(rawcolor);
+      _write_reg(0x63, rawcolor >>11);
+      _write_reg(0x64, rawcolor >> 5);
+      _write_reg(0x65, rawcolor     );
+    }
+    else
+    {
+      _write_reg(0x63, rawcolor >> 5);
+      _write_reg(0x64, rawcolor >> 2);
+      _write_reg(0x65, rawcolor     );
+    }
+  }
+
   void Panel_RA8875::_start_memorywrite(void)
   {
     if (_flg_memorywrite) { return; }
@@ -385,23 +442,7 @@ namespace lgfx
     }
     else
     {
-      if (_latestcolor != rawcolor)
-      {
-        _latestcolor = rawcolor;
-        if (_write_depth == rgb565_2Byte)
-        {
-          rawcolor = getSwap16(rawcolor);
-          _write_reg(0x63, rawcolor >>11);
-          _write_reg(0x64, rawcolor >> 5);
-          _write_reg(0x65, rawcolor     );
-        }
-        else
-        {
-          _write_reg(0x63, rawcolor >> 5);
-          _write_reg(0x64, rawcolor >> 2);
-          _write_reg(0x65, rawcolor     );
-        }
-      }
+      _set_fgcolor(rawcolor);
 
       uint_fast8_t r = _internal_rotation;
       if (r)
@@ -603,6 +644,83 @@ namespace lgfx
     _write_reg(0x50, 0x80);
   }
 
+  bool Panel_RA8875::drawLinePreclipped(uint_fast16_t x0, uint_fast16_t y0, uint_fast16_t x1, uint_fast16_t y1, uint32_t rawcolor)
+  {
+    // 水平・垂直線は writeFillRectPreclipped で1回の塗り潰しとなるため対象外;
+    if (x0 == x1 || y0 == y1) { return false; }
+    _set_fgcolor(rawcolor);
+    _rotate_pos(x0, y0);
+    _rotate_pos(x1, y1);
+    _write_pos_0x91(0x91, x0, y0);
+    _write_pos_0x91(0x95, x1, y1);
+    _write_reg(0x90, 0x80); // Draw Line.
+    return true;
+  }
+
+  bool Panel_RA8875::drawEllipsePreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t rx, uint_fast16_t ry, uint32_t rawcolor, bool fill)
+  {
+    // 半径のレジスタは10bit (円の場合は8bit);
+    if (rx == 0 || ry == 0 || rx > 1023 || ry > 1023) { return false; }
+    _set_fgcolor(rawcolor);
+    _rotate_pos(x, y);
+    if (_internal_rotation & 1) { std::swap(rx, ry); }
+    if (rx == ry && rx < 256)
+    {
+      _write_pos_0x91(0x99, x, y);
+      _write_reg_0x91(0x9D, rx);
+      _write_reg(0x90, fill ? 0x60 : 0x40); // Draw Circle.
+    }
+    else
+    {
+      _write_pos_0x91(0xA1, rx, ry);
+      _write_pos_0x91(0xA5, x, y);
+      _write_reg(0xA0, fill ? 0xC0 : 0x80); // Draw Ellipse.
+    }
+    return true;
+  }
+
+  bool Panel_RA8875::drawTrianglePreclipped(uint_fast16_t x0, uint_fast16_t y0, uint_fast16_t x1, uint_fast16_t y1, uint_fast16_t x2, uint_fast16_t y2, uint32_t rawcolor, bool fill)
+  {
+    _set_fgcolor(rawcolor);
+    _rotate_pos(x0, y0);
+    _rotate_pos(x1, y1);
+    _rotate_pos(x2, y2);
+    _write_pos_0x91(0x91, x0, y0);
+    _write_pos_0x91(0x95, x1, y1);
+    _write_pos_0x91(0xA9, x2, y2);
+    _write_reg(0x90, fill ? 0xA1 : 0x81); // Draw Triangle.
+    return true;
+  }
+
+  bool Panel_RA8875::drawRoundRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t r, uint32_t rawcolor, bool fill)
+  {
+    if (r == 0 && (fill || w == 1 || h == 1))
+    { // 塗り潰しと幅1の枠は BTE の塗り潰しで描く;
+      writeFillRectPreclipped(x, y, w, h, rawcolor);
+      return true;
+    }
+    if (r > 1023) { return false; }
+    _set_fgcolor(rawcolor);
+    uint_fast16_t xe = x + w - 1;
+    uint_fast16_t ye = y + h - 1;
+    _rotate_pos(x, y);
+    _rotate_pos(xe, ye);
+    if (x > xe) { std::swap(x, xe); }
+    if (y > ye) { std::swap(y, ye); }
+    _write_pos_0x91(0x91, x, y);
+    _write_pos_0x91(0x95, xe, ye);
+    if (r == 0)
+    {
+      _write_reg(0x90, 0x90); // Draw Square.
+    }
+    else
+    {
+      _write_pos_0x91(0xA1, r, r);
+      _write_reg(0xA0, fill ? 0xE0 : 0xA0); // Draw Circle Square.
+    }
+    return true;
+  }
+
   void Panel_RA8875::readRect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param)
   {
     uint_fast16_t bytes = param->dst_bits >> 3;
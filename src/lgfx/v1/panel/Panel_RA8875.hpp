@@ -59,6 +59,13 @@ namespace lgfx
     void readRect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param) override;
     void copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y) override;
 
+    /// 図形描画エンジンを使用する (直線・円・楕円・三角形・矩形・角丸矩形);
+    /// エンジンはパネル上の座標で描くため、回転時の直線・三角形の辺は ソフトウェア描画と端の画素の選び方が異なる場合がある;
+    bool drawLinePreclipped(uint_fast16_t x0, uint_fast16_t y0, uint_fast16_t x1, uint_fast16_t y1, uint32_t rawcolor) override;
+    bool drawEllipsePreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t rx, uint_fast16_t ry, uint32_t rawcolor, bool fill) override;
+    bool drawTrianglePreclipped(uint_fast16_t x0, uint_fast16_t y0, uint_fast16_t x1, uint_fast16_t y1, uint_fast16_t x2, uint_fast16_t y2, uint32_t rawcolor, bool fill) override;
+    bool drawRoundRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t r, uint32_t rawcolor, bool fill) override;
+
 
     void setInvert(bool invert) override {}; // Not yet implemented.
     void setSleep(bool flg) override {}; // Not yet implemented.
@@ -77,6 +84,7 @@ namespace lgfx
     bool _flg_serialbus = false;
     bool _flg_memorywrite = false;
     uint8_t _reg_0x51[16] = {0};
+    uint8_t _reg_0x91[28] = {0};
 
     const uint8_t* getInitCommands(uint8_t listno) const override;
     void begin_transaction(void);
@@ -88,6 +96,12 @@ namespace lgfx
     bool _wait_busy( uint32_t timeout = 1000);
     void _write_reg(uint8_t reg, uint8_t data);
     void _write_reg_0x51(uint8_t reg, uint8_t data);
+    void _write_reg_0x91(uint8_t reg, uint8_t data);
+    /// 図形描画エンジンの座標レジスタ (X下位,X上位,Y下位,Y上位の順) に書き込む;
+    void _write_pos_0x91(uint8_t reg, uint_fast16_t x, uint_fast16_t y);
+    /// 回転を反映したパネル上の座標に変換する;
+    void _rotate_pos(uint_fast16_t& x, uint_fast16_t& y) const;
+    void _set_fgcolor(uint32_t rawcolor);
     void _start_memorywrite(void);
   };
 
@@ -0,0 +1,390 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#include "Panel_Readback.hpp"
+
+#include "../misc/pixelcopy.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  bool Panel_Readback::init(bool use_reset)
+  {
+    if (_target == nullptr || !_target->init(use_reset)) return false;
+
+    _cfg = _target->config();
+    _bus = _target->bus();
+    _light = _target->light();
+    _epd_mode = _target->getEpdMode();
+    _auto_display = _target->getAutoDisplay();
+    _target->setAutoDisplay(false);  // 表示の更新はこちらのendWriteで行う;
+    setTouch(_target->touch());
+    // Panel_LCD等はsetRotationが呼ばれるまで width / height が確定しないため、ここで適用する;
+    _target->setRotation(_target->getRotation());
+    sync_state();
+    return create_shadow();
+  }
+
+  bool Panel_Readback::initTouch(void)
+  {
+    return _target->initTouch();
+  }
+
+  void Panel_Readback::initBus(void)
+  {
+    _target->initBus();
+  }
+
+  void Panel_Readback::releaseBus(void)
+  {
+    _target->releaseBus();
+  }
+
+  void Panel_Readback::sync_state(void)
+  {
+    _width = _target->width();
+    _height = _target->height();
+    _rotation = _target->getRotation();
+    _invert = _target->getInvert();
+    _write_depth = _target->getWriteDepth();
+  }
+
+  bool Panel_Readback::create_shadow(void)
+  {
+    uint_fast16_t w = _width;
+    uint_fast16_t h = _height;
+    if (_rotation & 1) { std::swap(w, h); }
+    auto depth = _write_depth;
+    if ((_shadow_depth == rgb332_1Byte || _shadow_depth == rgb565_2Byte)
+     && (_shadow_depth & color_depth_t::bit_mask) < _write_bits)
+    {
+      depth = _shadow_depth;
+    }
+    _read_depth = depth;  // 読出しは画面バッファから行う;
+    _shadow_src_raw = _shadow_dst_raw = 0;
+    _shadow.setColorDepth(depth);
+    color_conv_t conv(depth);
+    if (!_shadow.createSprite(w, h, &conv, _psram)) return false;
+    _shadow.setRotation(_rotation);
+    return true;
+  }
+
+  uint32_t Panel_Readback::shadow_color(uint32_t rawcolor)
+  {
+    if (!shadow_converts()) return rawcolor;
+    if (_shadow_src_raw != rawcolor)
+    { // 直前と同じ色であれば変換を省略する;
+      _shadow_src_raw = rawcolor;
+      _shadow_dst_raw = 0;
+      pixelcopy_t pc(&_shadow_src_raw, _shadow.getWriteDepth(), _write_depth);
+      pc.fp_copy(&_shadow_dst_raw, 0, 1, &pc);
+    }
+    return _shadow_dst_raw;
+  }
+
+  void Panel_Readback::write_shadow_image(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param)
+  {
+    if (!shadow_converts())
+    {
+      _shadow.writeImage(x, y, w, h, param, false);
+      return;
+    }
+    auto buf = (uint8_t*)alloca(w * (_write_bits >> 3) + 4);
+    pixelcopy_t pc_conv(buf, _shadow.getWriteDepth(), _write_depth);
+    pc_conv.src_bitwidth = w;
+    uint32_t sx32 = param->src_x32;
+    uint32_t sy32 = param->src_y32;
+    do
+    {
+      uint32_t pos = 0;
+      do
+      { // 透過色の部分は画面バッファに書込まない;
+        uint32_t start = pos;
+        pos = param->fp_copy(buf, pos, w, param);
+        if (pos != start)
+        {
+          pc_conv.src_x32 = start << pixelcopy_t::FP_SCALE;
+          pc_conv.src_y32 = 0;
+          pc_conv.src_x32_add = 1 << pixelcopy_t::FP_SCALE;  // 回転時は画面バッファ側で書き換えられる;
+          pc_conv.src_y32_add = 0;
+          _shadow.writeImage(x + start, y, pos - start, 1, &pc_conv, false);
+        }
+      } while (w != pos && w != (pos = param->fp_skip(pos, w, param)));
+      param->src_x32 = sx32;
+      param->src_y32 = (sy32 += 1 << pixelcopy_t::FP_SCALE);
+      ++y;
+    } while (--h);
+  }
+
+  void Panel_Readback::write_shadow_pixels(pixelcopy_t* param, uint32_t len)
+  {
+    if (!shadow_converts())
+    {
+      _shadow.writePixels(param, len, false);
+      return;
+    }
+    uint8_t buf[192];
+    uint32_t chunk = sizeof(buf) / (_write_bits >> 3);
+    pixelcopy_t pc_conv(buf, _shadow.getWriteDepth(), _write_depth);
+    do
+    {
+      uint32_t l = std::min(len, chunk);
+      param->fp_copy(buf, 0, l, param);
+      pc_conv.src_x32 = 0;
+      pc_conv.src_y32 = 0;
+      pc_conv.src_x32_add = 1 << pixelcopy_t::FP_SCALE;
+      pc_conv.src_y32_add = 0;
+      _shadow.writePixels(&pc_conv, l, false);
+      len -= l;
+    } while (len);
+  }
+
+  void Panel_Readback::push_shadow(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h)
+  {
+    size_t line_bytes = (w * _write_bits + 7) >> 3;
+    uint_fast16_t lines = std::max<size_t>(1, std::min<size_t>(h, 1024 / line_bytes));
+    auto buf = (uint8_t*)heap_alloc_dma(lines * line_bytes + 4);
+    if (buf == nullptr) return;
+    pixelcopy_t pc_read(nullptr, _write_depth, _read_depth);
+    _target->startWrite();
+    do
+    {
+      uint_fast16_t lh = std::min(lines, h);
+      pc_read.src_x32_add = 1 << pixelcopy_t::FP_SCALE;
+      pc_read.src_y32_add = 0;
+      _shadow.readRect(x, y, w, lh, buf, &pc_read);
+      pixelcopy_t pc_write(buf, _write_depth, _write_depth);
+      pc_write.src_bitwidth = w;
+      _target->writeImage(x, y, w, lh, &pc_write, false);
+      y += lh;
+      h -= lh;
+    } while (h);
+    _target->endWrite();
+    heap_free(buf);
+  }
+
+  void Panel_Readback::beginTransaction(void)
+  {
+    _target->startWrite();
+  }
+
+  void Panel_Readback::endTransaction(void)
+  {
+    _target->endWrite();
+  }
+
+  void Panel_Readback::setBrightness(uint8_t brightness)
+  {
+    _target->setBrightness(brightness);
+  }
+
+  color_depth_t Panel_Readback::setColorDepth(color_depth_t depth)
+  {
+    auto res = _target->setColorDepth(depth);
+    if (_write_depth != _target->getWriteDepth())
+    {
+      sync_state();
+      create_shadow();  // 色深度が変わった場合は画面バッファを作り直す (内容は失われる);
+    }
+    return res;
+  }
+
+  void Panel_Readback::setInvert(bool invert)
+  {
+    _target->setInvert(invert);
+    _invert = _target->getInvert();
+  }
+
+  void Panel_Readback::setRotation(uint_fast8_t r)
+  {
+    _target->setRotation(r);
+    sync_state();
+    _shadow.setRotation(_rotation);
+    _xs = _ys = 0;
+    _xe = _width - 1;
+    _ye = _height - 1;
+  }
+
+  void Panel_Readback::setSleep(bool flg_sleep)
+  {
+    _target->setSleep(flg_sleep);
+  }
+
+  void Panel_Readback::setPowerSave(bool flg_idle)
+  {
+    _target->setPowerSave(flg_idle);
+  }
+
+  void Panel_Readback::writeCommand(uint32_t cmd, uint_fast8_t length)
+  {
+    _target->writeCommand(cmd, length);
+  }
+
+  void Panel_Readback::writeData(uint32_t data, uint_fast8_t length)
+  {
+    _target->writeData(data, length);
+  }
+
+  void Panel_Readback::initDMA(void)
+  {
+    _target->initDMA();
+  }
+
+  void Panel_Readback::waitDMA(void)
+  {
+    _target->waitDMA();
+  }
+
+  bool Panel_Readback::dmaBusy(void)
+  {
+    return _target->dmaBusy();
+  }
+
+  void Panel_Readback::waitDisplay(void)
+  {
+    _target->waitDisplay();
+  }
+
+  bool Panel_Readback::displayBusy(void)
+  {
+    return _target->displayBusy();
+  }
+
+  void Panel_Readback::display(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h)
+  {
+    _target->display(x, y, w, h);
+  }
+
+  bool Panel_Readback::isBusShared(void) const
+  {
+    return _target->isBusShared();
+  }
+
+  void Panel_Readback::writeBlock(uint32_t rawcolor, uint32_t len)
+  {
+    _target->writeBlock(rawcolor, len);
+    _shadow.writeBlock(shadow_color(rawcolor), len);
+  }
+
+  void Panel_Readback::setWindow(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye)
+  {
+    _xs = xs;
+    _ys = ys;
+    _xe = xe;
+    _ye = ye;
+    _target->setWindow(xs, ys, xe, ye);
+    _shadow.setWindow(xs, ys, xe, ye);
+  }
+
+  void Panel_Readback::drawPixelPreclipped(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor)
+  {
+    _target->drawPixelPreclipped(x, y, rawcolor);
+    _shadow.drawPixelPreclipped(x, y, shadow_color(rawcolor));
+  }
+
+  void Panel_Readback::writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor)
+  {
+    _target->writeFillRectPreclipped(x, y, w, h, rawcolor);
+    _shadow.writeFillRectPreclipped(x, y, w, h, shadow_color(rawcolor));
+  }
+
+  void Panel_Readback::writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool use_dma)
+  {
+    // 転送側がparamを書き換えるため、元の状態から画面バッファ側にも同じ内容を書く;
+    // (DMA転送中に画面バッファへの書込みが並行して行われる);
+    // 画面バッファ側は回転の際に src_x32_add 等も書き換えるため、呼出し元には転送側の状態を返す;
+    auto pc = *param;
+    _target->writeImage(x, y, w, h, param, use_dma);
+    std::swap(pc, *param);
+    write_shadow_image(x, y, w, h, param);
+    *param = pc;
+  }
+
+  void Panel_Readback::writePixels(pixelcopy_t* param, uint32_t len, bool use_dma)
+  {
+    auto pc = *param;
+    _target->writePixels(param, len, use_dma);
+    std::swap(pc, *param);
+    write_shadow_pixels(param, len);
+    *param = pc;
+  }
+
+  void Panel_Readback::writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param)
+  {
+    auto pc = *param;
+    if (!shadow_converts())
+    { // 合成は画面バッファ上で行い、結果を転送する;
+      _shadow.writeImageARGB(x, y, w, h, &pc);
+      push_shadow(x, y, w, h);
+      return;
+    }
+    // paramはパネルの色深度向けのため、画面バッファの内容をパネルの色深度で読出して1行ずつ合成する;
+    auto buf = (uint8_t*)alloca(w * (_write_bits >> 3) + 4);
+    pixelcopy_t pc_read(nullptr, _write_depth, _read_depth);
+    pixelcopy_t pc_write(buf, _write_depth, _write_depth);
+    pc_write.src_bitwidth = w;
+    uint32_t sx32 = pc.src_x32;
+    uint32_t sy32 = pc.src_y32;
+    _target->startWrite();
+    do
+    {
+      pc_read.src_x32_add = 1 << pixelcopy_t::FP_SCALE;
+      pc_read.src_y32_add = 0;
+      _shadow.readRect(x, y, w, 1, buf, &pc_read);
+      pc.fp_copy(buf, 0, w, &pc);
+      pc.src_x32 = sx32;
+      pc.src_y32 = (sy32 += 1 << pixelcopy_t::FP_SCALE);
+      pc_write.src_x32 = 0;
+      pc_write.src_y32 = 0;
+      writeImage(x, y, w, 1, &pc_write, false);
+      ++y;
+    } while (--h);
+    _target->endWrite();
+  }
+
+  uint32_t Panel_Readback::readCommand(uint_fast8_t cmd, uint_fast8_t index, uint_fast8_t len)
+  {
+    return _target->readCommand(cmd, index, len);
+  }
+
+  uint32_t Panel_Readback::readData(uint_fast8_t index, uint_fast8_t len)
+  {
+    return _target->readData(index, len);
+  }
+
+  void Panel_Readback::readRect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param)
+  {
+    // 回転時は画面バッファ側が src_x32_add 等を書き換えるため、呼出し元が同じparamを再利用できるよう元に戻す;
+    auto addx = param->src_x32_add;
+    auto addy = param->src_y32_add;
+    _shadow.readRect(x, y, w, h, dst, param);
+    param->src_x32_add = addx;
+    param->src_y32_add = addy;
+  }
+
+  void Panel_Readback::copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y)
+  {
+    _shadow.copyRect(dst_x, dst_y, w, h, src_x, src_y);
+    push_shadow(dst_x, dst_y, w, h);
+  }
+
+//----------------------------------------------------------------------------
+ }
+}
@@ -0,0 +1,115 @@
+/*----------------------------------------------------------------------------/
+  Lovyan GFX - Graphics library for embedded devices.
+
+Original Source:
+ https://github.com/lovyan03/LovyanGFX/
+
+Licence:
+ [FreeBSD](https://github.com/lovyan03/LovyanGFX/blob/master/license.txt)
+
+Author:
+ [lovyan03](https://twitter.com/lovyan03)
+
+Contributors:
+ [ciniml](https://github.com/ciniml)
+ [mongonta0716](https://github.com/mongonta0716)
+ [tobozo](https://github.com/tobozo)
+/----------------------------------------------------------------------------*/
+#pragma once
+
+#include "Panel_Device.hpp"
+#include "../LGFX_Sprite.hpp"
+
+namespace lgfx
+{
+ inline namespace v1
+ {
+//----------------------------------------------------------------------------
+
+  /// 別のパネルへの描画を全てメモリ上の画面バッファにも反映し、読出しをメモリから行うパネル。;
+  /// 読出しできない・読出しが遅いパネル (I2C, 3線SPI, M5UnitLCD等) で readRect / 半透明合成 / floodFill 等を使う場合に用いる;
+  /// 使い方: setPanel(&_panel_instance) の代わりに _readback.setTarget(&_panel_instance); setPanel(&_readback);
+  struct Panel_Readback : public Panel_Device
+  {
+  public:
+    Panel_Readback(void) = default;
+    Panel_Readback(Panel_Device* target) { setTarget(target); }
+    virtual ~Panel_Readback(void) { _shadow.deleteSprite(); }
+
+    void setTarget(Panel_Device* target) { _target = target; _epd_mode = target ? target->getEpdMode() : (epd_mode_t)0; }
+    Panel_Device* getTarget(void) const { return _target; }
+
+    /// 画面バッファをPSRAMに確保する (init前に設定すること);
+    void setPsram(bool psram) { _psram = psram; }
+
+    /// 画面バッファの色深度を指定する (init前に設定すること。rgb332_1Byte / rgb565_2Byte);
+    /// パネルより低い色深度にするとメモリを節約できるが、読出しと半透明合成・copyRectの結果はこの色深度に丸められる;
+    /// パネルの色深度以上を指定した場合はパネルと同じ色深度になる;
+    void setShadowDepth(color_depth_t depth) { _shadow_depth = depth; }
+
+    void* getShadowBuffer(void) const { return _shadow.getBuffer(); }
+
+    bool init(bool use_reset) override;
+    bool initTouch(void) override;
+    void initBus(void) override;
+    void releaseBus(void) override;
+
+    void beginTransaction(void) override;
+    void endTransaction(void) override;
+
+    void setBrightness(uint8_t brightness) override;
+    color_depth_t setColorDepth(color_depth_t depth) override;
+    void setInvert(bool invert) override;
+    void setRotation(uint_fast8_t r) override;
+    void setSleep(bool flg_sleep) override;
+    void setPowerSave(bool flg_idle) override;
+
+    void writeCommand(uint32_t cmd, uint_fast8_t length) override;
+    void writeData(uint32_t data, uint_fast8_t length) override;
+
+    void initDMA(void) override;
+    void waitDMA(void) override;
+    bool dmaBusy(void) override;
+    void waitDisplay(void) override;
+    bool displayBusy(void) override;
+    void display(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h) override;
+    bool isReadable(void) const override { return true; }
+    bool isBusShared(void) const override;
+
+    void writeBlock(uint32_t rawcolor, uint32_t len) override;
+    void setWindow(uint_fast16_t xs, uint_fast16_t ys, uint_fast16_t xe, uint_fast16_t ye) override;
+    void drawPixelPreclipped(uint_fast16_t x, uint_fast16_t y, uint32_t rawcolor) override;
+    void writeFillRectPreclipped(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, uint32_t rawcolor) override;
+    void writeImage(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param, bool use_dma) override;
+    void writeImageARGB(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param) override;
+    void writePixels(pixelcopy_t* param, uint32_t len, bool use_dma) override;
+
+    uint32_t readCommand(uint_fast8_t cmd, uint_fast8_t index, uint_fast8_t len) override;
+    uint32_t readData(uint_fast8_t index, uint_fast8_t len) override;
+    void readRect(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, void* dst, pixelcopy_t* param) override;
+    void copyRect(uint_fast16_t dst_x, uint_fast16_t dst_y, uint_fast16_t w, uint_fast16_t h, uint_fast16_t src_x, uint_fast16_t src_y) override;
+
+  protected:
+    Panel_Device* _target = nullptr;
+    Panel_Sprite _shadow;
+    bool _psram = false;
+    color_depth_t _shadow_depth = (color_depth_t)0;
+    uint32_t _shadow_src_raw = 0;
+    uint32_t _shadow_dst_raw = 0;
+
+    bool create_shadow(void);
+    void sync_state(void);
+    /// 画面バッファの色深度がパネルと異なるか;
+    bool shadow_converts(void) const { return _shadow.getWriteDepth() != _write_depth; }
+    /// パネルの色深度の値を画面バッファの色深度に変換する;
+    uint32_t shadow_color(uint32_t rawcolor);
+    /// paramの内容をパネルの色深度で展開し、画面バッファの色深度に変換して書込む;
+    void write_shadow_image(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h, pixelcopy_t* param);
+    void write_shadow_pixels(pixelcopy_t* param, uint32_t len);
+    /// 画面バッファの内容を対象パネルへ送る;
+    void push_shadow(uint_fast16_t x, uint_fast16_t y, uint_fast16_t w, uint_fast16_t h);
+  };
+
+//----------------------------------------------------------------------------
+ }
+}
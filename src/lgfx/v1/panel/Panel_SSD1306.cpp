@@ -66,8 +66,21 @@ namespace lgfx
     return ((_cfg.panel_height + 7) >> 3) * _cfg.panel_width;
   }
 
+  Panel_1bitOLED::~Panel_1bitOLED(void)
+  {
+    if (_page_mod) { heap_free(_page_mod); }
+  }
+
   bool Panel_1bitOLED::init(bool use_reset)
   {
+    if (_page_mod) { heap_free(_page_mod); }
+    _page_mod = static_cast<range_t*>(heap_alloc(((_cfg.panel_height + 7) >> 3) * sizeof(range_t)));
+    if (_page_mod == nullptr)
+    {
+      return false;
+    }
+    _clear_modified_rect();
+
     if (!Panel_HasBuffer::init(use_reset))
     {
       return false;
@@ -250,10 +263,76 @@ namespace lgfx
   void Panel_1bitOLED::_update_transferred_rect(uint_fast16_t &xs, uint_fast16_t &ys, uint_fast16_t &xe, uint_fast16_t &ye)
   {
     _rotate_pos(xs, ys, xe, ye);
+    _add_modified_rect(xs, ys, xe, ye);
+  }
+
+  void Panel_1bitOLED::_add_modified_rect(int_fast16_t xs, int_fast16_t ys, int_fast16_t xe, int_fast16_t ye)
+  {
+    xe = std::min<int_fast16_t>(xe, _cfg.panel_width  - 1);
+    ye = std::min<int_fast16_t>(ye, _cfg.panel_height - 1);
+    if (xe < xs || ye < ys) { return; }
+
     _range_mod.left   = std::min<int32_t>(xs, _range_mod.left);
     _range_mod.right  = std::max<int32_t>(xe, _range_mod.right);
     _range_mod.top    = std::min<int32_t>(ys, _range_mod.top);
     _range_mod.bottom = std::max<int32_t>(ye, _range_mod.bottom);
+
+    if (!_page_mod) { return; }
+    for (int_fast16_t page = ys >> 3; page <= (ye >> 3); ++page)
+    {
+      auto &r = _page_mod[page];
+      if (r.first > xs) { r.first = xs; }
+      if (r.last  < xe) { r.last  = xe; }
+    }
+  }
+
+  bool Panel_1bitOLED::_narrow_modified_rect(void)
+  {
+    if (_range_mod.empty()) { return false; }
+    if (!_shadow_valid) { return true; }
+    bool res = false;
+    for (int_fast16_t page = _range_mod.top >> 3; page <= (_range_mod.bottom >> 3); ++page)
+    {
+      auto &r = _page_mod[page];
+      if (r.empty()) { continue; }
+      uint_fast16_t xs = r.first;
+      uint_fast16_t xe = r.last;
+      if (_shadow_diff(page * _cfg.panel_width, xs, xe))
+      {
+        r.first = xs;
+        r.last  = xe;
+        res = true;
+      }
+      else
+      {
+        r.first = INT16_MAX;
+        r.last  = 0;
+      }
+    }
+    if (!res) { _clear_modified_rect(); }
+    return res;
+  }
+
+  void Panel_1bitOLED::_update_shadow(void)
+  {
+    range_rect_t r = _range_mod;
+    r.top    >>= 3;
+    r.bottom >>= 3;
+    _shadow_update(r, _cfg.panel_width, 0);
+  }
+
+  void Panel_1bitOLED::_clear_modified_rect(void)
+  {
+    _range_mod.top    = INT16_MAX;
+    _range_mod.left   = INT16_MAX;
+    _range_mod.right  = 0;
+    _range_mod.bottom = 0;
+    if (!_page_mod) { return; }
+    for (size_t page = 0, pages = (_cfg.panel_height + 7) >> 3; page < pages; ++page)
+    {
+      _page_mod[page].first = INT16_MAX;
+      _page_mod[page].last  = 0;
+    }
   }
 
 //----------------------------------------------------------------------------
@@ -289,36 +368,44 @@ namespace lgfx
   {
     if (0 < w && 0 < h)
     {
-      _range_mod.left   = std::min<int_fast16_t>(_range_mod.left  , x        );
-      _range_mod.right  = std::max<int_fast16_t>(_range_mod.right , x + w - 1);
-      _range_mod.top    = std::min<int_fast16_t>(_range_mod.top   , y        );
-      _range_mod.bottom = std::max<int_fast16_t>(_range_mod.bottom, y + h - 1);
+      _add_modified_rect(x, y, x + w - 1, y + h - 1);
     }
-    if (_range_mod.empty()) { return; }
+    if (!_narrow_modified_rect()) { return; }
 
-    uint_fast8_t xs = _range_mod.left;
-    uint_fast8_t xe = _range_mod.right;
-    uint_fast8_t ys = _range_mod.top    >> 3;
-    uint_fast8_t ye = _range_mod.bottom >> 3;
-    int retry = 3;
-    while (!(_bus->writeCommand(CMD_COLUMNADDR| (xs +  _cfg.offset_x      ) << 8 | (xe +  _cfg.offset_x      ) << 16, 24)
-          && _bus->writeCommand(CMD_PAGEADDR  | (ys + (_cfg.offset_y >> 3)) << 8 | (ye + (_cfg.offset_y >> 3)) << 16, 24)) && --retry)
-    {
-      _bus->endTransaction();
-      _bus->beginTransaction();
-    }
-    if (retry)
+    uint_fast8_t page = _range_mod.top    >> 3;
+    uint_fast8_t last = _range_mod.bottom >> 3;
+    do
     {
+      auto span = _page_mod[page];
+      if (span.empty()) { continue; }
+
+      // 列の範囲が同じページが続く場合は1回のアドレス指定でまとめて送る;
+      uint_fast8_t ys = page;
+      while (page < last && _page_mod[page + 1].first == span.first && _page_mod[page + 1].last == span.last) { ++page; }
+      uint_fast8_t ye = page;
+      uint_fast8_t xs = span.first;
+      uint_fast8_t xe = span.last;
+
+      int retry = 3;
+      while (!(_bus->writeCommand(CMD_COLUMNADDR| (xs +  _cfg.offset_x      ) << 8 | (xe +  _cfg.offset_x      ) << 16, 24)
+            && _bus->writeCommand(CMD_PAGEADDR  | (ys + (_cfg.offset_y >> 3)) << 8 | (ye + (_cfg.offset_y >> 3)) << 16, 24)) && --retry)
+      {
+        _bus->endTransaction();
+        _bus->beginTransaction();
+      }
+      if (!retry) { return; }
+
       do
       {
         auto buf = &_buf[xs + ys * _cfg.panel_width];
         _bus->writeBytes(buf, xe - xs + 1, true, true);
+        _page_mod[ys].first = INT16_MAX;
+        _page_mod[ys].last  = 0;
       } while (++ys <= ye);
-      _range_mod.top    = INT16_MAX;
-      _range_mod.left   = INT16_MAX;
-      _range_mod.right  = 0;
-      _range_mod.bottom = 0;
-    }
+    } while (++page <= last);
+
+    _update_shadow();
+    _clear_modified_rect();
   }
 
 //----------------------------------------------------------------------------
@@ -334,24 +421,24 @@ namespace lgfx
   {
     if (0 < w && 0 < h)
     {
-      _range_mod.left   = std::min<int_fast16_t>(_range_mod.left  , x        );
-      _range_mod.right  = std::max<int_fast16_t>(_range_mod.right , x + w - 1);
-      _range_mod.top    = std::min<int_fast16_t>(_range_mod.top   , y        );
-      _range_mod.bottom = std::max<int_fast16_t>(_range_mod.bottom, y + h - 1);
+      _add_modified_rect(x, y, x + w - 1, y + h - 1);
     }
-    if (_range_mod.empty()) { return; }
+    if (!_narrow_modified_rect()) { return; }
 
-    uint_fast8_t xs = _range_mod.left ;
-    uint_fast8_t xe = _range_mod.right;
     uint_fast8_t ys = _range_mod.top    >> 3;
     uint_fast8_t ye = _range_mod.bottom >> 3;
 
     uint_fast8_t offset_y = _cfg.offset_y >> 3;
-    uint_fast8_t offset_x = _cfg.offset_x + xs;
 
     int retry = 3;
     do
     {
+      auto span = _page_mod[ys];
+      if (span.empty()) { continue; }
+
+      uint_fast8_t xs = span.first;
+      uint_fast8_t xe = span.last;
+      uint_fast8_t offset_x = _cfg.offset_x + xs;
       while (!_bus->writeCommand(  CMD_SETPAGEADDR | (ys + offset_y)
                                 | (CMD_SETHIGHCOLUMN + (offset_x >> 4)) << 8
                                 | (CMD_SETLOWCOLUMN  + (offset_x & 0x0F)) << 16
@@ -366,10 +453,8 @@ namespace lgfx
       _bus->writeBytes(buf, xe - xs + 1, true, true);
     } while (++ys <= ye);
 
-    _range_mod.top    = INT16_MAX;
-    _range_mod.left   = INT16_MAX;
-    _range_mod.right  = 0;
-    _range_mod.bottom = 0;
+    if (retry) { _update_shadow(); }
+    _clear_modified_rect();
   }
 
 //----------------------------------------------------------------------------
@@ -28,6 +28,8 @@ namespace lgfx
 
   struct Panel_1bitOLED : public Panel_HasBuffer
   {
+    virtual ~Panel_1bitOLED(void);
+
     bool init(bool use_reset) override;
 
     void waitDisplay(void) override;
@@ -60,10 +62,17 @@ namespace lgfx
     static constexpr uint8_t CMD_SETPRECHARGE        = 0xD9;
     static constexpr uint8_t CMD_SETVCOMDETECT       = 0xDB;
 
+    /// 8行単位のページ毎に変更のあった列の範囲。display時に変更のあった範囲だけを送信する;
+    range_t* _page_mod = nullptr;
+
     size_t _get_buffer_length(void) const override;
     bool _read_pixel(uint_fast16_t x, uint_fast16_t y);
     void _draw_pixel(uint_fast16_t x, uint_fast16_t y, uint32_t value);
     void _update_transferred_rect(uint_fast16_t &xs, uint_fast16_t &ys, uint_fast16_t &xe, uint_fast16_t &ye);
+    void _add_modified_rect(int_fast16_t xs, int_fast16_t ys, int_fast16_t xe, int_fast16_t ye);
+    void _clear_modified_rect(void);
+    bool _narrow_modified_rect(void);
+    void _update_shadow(void);
 
   };
 
@@ -270,23 +270,29 @@ namespace lgfx
 
     if (_range_mod.empty()) { return; }
 
-    uint_fast8_t xs = _range_mod.left  >> 1;
-    uint_fast8_t xe = _range_mod.right >> 1;
-    uint_fast8_t ofs = _cfg.offset_x >> 1;
+    size_t stride = (_cfg.panel_width + 1) >> 1;
+    if (_shadow_narrow(_range_mod, stride, 1))
+    {
+      uint_fast8_t xs = _range_mod.left  >> 1;
+      uint_fast8_t xe = _range_mod.right >> 1;
+      uint_fast8_t ofs = _cfg.offset_x >> 1;
 
-    _bus->writeCommand(CMD_CASET | (xs + ofs) << 8 | (xe + ofs) << 16, 24);
+      _bus->writeCommand(CMD_CASET | (xs + ofs) << 8 | (xe + ofs) << 16, 24);
 
-    uint_fast8_t ys = _range_mod.top    + _cfg.offset_y;
-    uint_fast8_t ye = _range_mod.bottom + _cfg.offset_y;
-    ofs = _cfg.offset_y;
-    _bus->writeCommand(CMD_RASET | (ys + ofs) << 8 | (ye + ofs) << 16, 24);
+      uint_fast8_t ys = _range_mod.top;
+      uint_fast8_t ye = _range_mod.bottom;
+      ofs = _cfg.offset_y;
+      _bus->writeCommand(CMD_RASET | (ys + ofs) << 8 | (ye + ofs) << 16, 24);
 
-    w = xe - xs + 1;
-    do
-    {
-      auto buf = &_buf[xs + ys * ((_cfg.panel_width + 1) >> 1 )]; 
-      _bus->writeBytes(buf, w, true, true);
-    } while (++ys <= ye);
+      w = xe - xs + 1;
+      do
+      {
+        auto buf = &_buf[xs + ys * stride];
+        _bus->writeBytes(buf, w, true, true);
+      } while (++ys <= ye);
+
+      _shadow_update(_range_mod, stride, 1);
+    }
 
     _range_mod.top    = INT16_MAX;
     _range_mod.left   = INT16_MAX;
@@ -35,6 +35,7 @@ namespace lgfx
 
       _cmd_nop = CMD_NOP;
       _cmd_ramrd = CMD_RAMRD;
+      _cmd_vscrdef = 0;  // ハードウェアスクロールのコマンド体系が異なるため使用しない;
     }
 
     void setInvert(bool invert) override;
@@ -64,6 +64,7 @@ namespace lgfx
       _cfg.memory_height = _cfg.panel_height = 480;
       _write_depth = rgb565_2Byte;
       _read_depth  = rgb565_2Byte;
+      _cmd_vscrdef = 0;  // ハードウェアスクロールのコマンド体系が異なるため使用しない;
     }
 
     void setHSync(uint_fast16_t front, uint_fast16_t sync, uint_fast16_t back, uint_fast16_t move = 0, uint_fast16_t lpspp = 0);
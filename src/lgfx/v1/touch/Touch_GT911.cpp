@@ -159,7 +159,8 @@ namespace lgfx
     {
       /// GT911は値を0x814Eに0を書くまで同じ値を維持する挙動となっているため、;
       /// 前回からの間隔が長すぎると古い情報が得られるので更新のため2回取得する;
-      bool flg = (diff_msec > _refresh_rate << 4);
+      /// (INTピンがある場合は割込み時点の新しい値が得られるため、待ち時間を入れない);
+      bool flg = (_cfg.pin_int < 0) && (diff_msec > _refresh_rate << 4);
       if (!_update_data() || flg)
       {
         if (flg)
@@ -24,8 +24,14 @@ Contributors:
 #include "v1/lgfx_filesystem_support.hpp"
 #include "v1/LGFXBase.hpp"
 #include "v1/LGFX_Sprite.hpp"
+#include "v1/LGFX_CompressedSprite.hpp"
+#include "v1/LGFX_Static.hpp"
 #include "v1/LGFX_Button.hpp"
 #include "v1/Light.hpp"
+#include "v1/bus/Bus_Stats.hpp"
+#include "v1/bus/Bus_Trace.hpp"
+#include "v1/bus/Bus_DCS.hpp"
+#include "v1/bus/Bus_RA8875.hpp"
 #include "v1/panel/Panel_GC9A01.hpp"
 #include "v1/panel/Panel_ILI9163.hpp"
 #include "v1/panel/Panel_ILI9225.hpp"
@@ -44,6 +50,7 @@ Contributors:
 #include "v1/panel/Panel_M5UnitLCD.hpp"
 #include "v1/panel/Panel_GDEW0154M09.hpp"
 #include "v1/panel/Panel_IT8951.hpp"
+#include "v1/panel/Panel_Readback.hpp"
 #include "v1/touch/Touch_FT5x06.hpp"
 #include "v1/touch/Touch_GSLx680.hpp"
 #include "v1/touch/Touch_GT911.hpp"